@@ -1,6 +1,7 @@
 //                    SPIKE ENGINE
 //Copyright 2021 - SpikeTechnologies - All Rights Reserved
 #include "EditorLayer.h"
+#include "Spike/Core/MemoryTracker.h"
 #include "Spike/Scene/SceneSerializer.h"
 #include "Spike/Utility/FileDialogs.h"
 #include "Spike/Math/Math.h"
@@ -87,6 +88,7 @@ namespace Spike
 
     void EditorLayer::OnUpdate(Timestep ts)
     {
+        SPK_MEMORY_TAG(Editor);
         // Resize
         FramebufferSpecification spec = m_Framebuffer->GetSpecification();
         if ( m_ViewportSize.x > 0.0f && m_ViewportSize.y > 0.0f && (spec.Width != m_ViewportSize.x || spec.Height != m_ViewportSize.y))
@@ -125,6 +127,7 @@ namespace Spike
 
     void EditorLayer::OnImGuiRender()
     {
+        SPK_MEMORY_TAG(Editor);
         GUI::BeginDockspace();
         if (ImGui::BeginMenuBar())
         {
@@ -369,7 +372,7 @@ namespace Spike
                 auto cameraEntity = m_EditorScene->GetPrimaryCameraEntity();
                 const auto& camera = cameraEntity.GetComponent<CameraComponent>().Camera;
                 cameraProjection = camera.GetProjection();
-                cameraView = glm::inverse(cameraEntity.GetComponent<TransformComponent>().GetTransform());
+                cameraView = glm::inverse(cameraEntity.GetComponent<TransformComponent>().GetWorldTransform());
             }
 
             if (m_SceneState == SceneState::Edit)
@@ -380,7 +383,7 @@ namespace Spike
 
             // Entity transform
             auto& tc = selectedEntity.GetComponent<TransformComponent>();
-            glm::mat4 transform = tc.GetTransform();
+            glm::mat4 transform = tc.GetWorldTransform();
 
             // Snapping
             bool snap = Input::IsKeyPressed(Key::LeftControl);
@@ -397,6 +400,11 @@ namespace Spike
             if (ImGuizmo::IsUsing())
             {
                 m_GizmoInUse = true;
+                // The gizmo works in world space, bring the result back into the parent's space
+                Entity parent = m_EditorScene->GetParent(selectedEntity);
+                if (parent)
+                    transform = glm::inverse(parent.GetComponent<TransformComponent>().GetWorldTransform()) * transform;
+
                 glm::vec3 translation, rotation, scale;
                 Math::DecomposeTransform(transform, translation, rotation, scale);
 
@@ -419,7 +427,7 @@ namespace Spike
             m_SceneHierarchyPanel.OnImGuiRender(&s_ShowHierarchyAndInspectorPanel);
 
         if(s_ShowRendererProfilerPanel)
-            m_ProfilerPanel.OnImGuiRender(&s_ShowRendererProfilerPanel);
+            m_ProfilerPanel.OnImGuiRender(&s_ShowRendererProfilerPanel, m_SceneHierarchyPanel.GetCurrentScene());
 
         if(s_ShowVaultAndCachePanel)
             m_VaultPanel.OnImGuiRender(&s_ShowVaultAndCachePanel);
@@ -2,6 +2,8 @@
 //Copyright 2021 - SpikeTechnologies - All Rights Reserved
 #include "ConsolePanel.h"
 #include "UIUtils/UIUtils.h"
+#include <cctype>
+#include <cstring>
 
 namespace Spike
 {
@@ -25,48 +27,117 @@ namespace Spike
 
         ImGui::Begin(ICON_FK_LIST" Console", show);
 
-        if (ImGui::Button("Clear") || m_Messages.size() > 9999)
-            ClearLog();
+        // Print is called from the logging thread, so m_Mutex is only held to read the ring, never while ImGui draws
+        size_t counts[SeverityCount];
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            for (Uint i = 0; i < SeverityCount; i++)
+                counts[i] = m_SeverityIndices[i].size();
+        }
+
+        const bool clear = ImGui::Button("Clear");
 
         ImGui::SameLine();
         GUI::DrawDynamicToggleButton(ICON_FK_TIMES, ICON_FK_CHECK, { 0.7f, 0.1f, 0.1f, 1.0f }, { 0.2f, 0.5f, 0.2f, 1.0f }, &m_ScrollLockEnabled);
         GUI::DrawToolTip("Scroll lock");
 
+        // What's still in the ring, whatever the filter
+        auto drawCountToolTip = [&](const char* label, Severity level)
+        {
+            char tooltip[64];
+            snprintf(tooltip, sizeof(tooltip), "%s (%zu)", label, counts[(Uint)level]);
+            GUI::DrawToolTip(tooltip);
+        };
+
         ImGui::SameLine();
         GUI::DrawColorChangingToggleButton(ICON_FK_PAPERCLIP, m_DisabledColor, m_EnabledColor, m_TraceColor, &m_TraceEnabled);
+        drawCountToolTip("Trace", Severity::Trace);
         ImGui::SameLine();
         GUI::DrawColorChangingToggleButton(ICON_FK_INFO_CIRCLE, m_DisabledColor, m_EnabledColor, m_InfoColor, &m_InfoEnabled);
+        drawCountToolTip("Info", Severity::Info);
         ImGui::SameLine();
         GUI::DrawColorChangingToggleButton(ICON_FK_BUG, m_DisabledColor, m_EnabledColor, m_DebugColor, &m_DebugEnabled);
+        drawCountToolTip("Debug", Severity::Debug);
         ImGui::SameLine();
         GUI::DrawColorChangingToggleButton(ICON_FK_EXCLAMATION_TRIANGLE, m_DisabledColor, m_EnabledColor, m_WarnColor, &m_WarningEnabled);
+        drawCountToolTip("Warnings", Severity::Warning);
         ImGui::SameLine();
         GUI::DrawColorChangingToggleButton(ICON_FK_EXCLAMATION_CIRCLE, m_DisabledColor, m_EnabledColor, m_ErrorColor, &m_ErrorEnabled);
+        drawCountToolTip("Errors", Severity::Error);
+        ImGui::SameLine();
+        if (ImGui::Button(ICON_FK_FILTER))
+            ImGui::OpenPopup("LogCategories");
+        GUI::DrawToolTip("Log categories");
+        if (ImGui::BeginPopup("LogCategories"))
+        {
+            // Unlike the toggles above this filters before anything is logged, what's below a threshold is gone
+            for (LogCategory* category : Logger::GetCategories())
+            {
+                int threshold = (int)category->Threshold.load();
+                ImGui::SetNextItemWidth(120.0f);
+                if (ImGui::Combo(category->Name.c_str(), &threshold, "TRACE\0INFO\0DEBUG\0WARNING\0ERROR\0CRITICAL\0"))
+                    Logger::SetThreshold(category->Name.c_str(), (Severity)threshold);
+            }
+            ImGui::EndPopup();
+        }
+
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(200.0f);
+        ImGui::InputTextWithHint("##Search", ICON_FK_SEARCH" Search", m_SearchBuffer, sizeof(m_SearchBuffer));
+
+        // The view and the filter state are only touched here, Print leaves them alone
+        bool filtering = false;
+        uint64_t inRing = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if (clear)
+                ClearLog();
+            ApplyFilter();
+            Scan();
+            const uint64_t oldest = GetOldest();
+            while (!m_View.empty() && m_View.front() < oldest)
+                m_View.pop_front();
+            filtering = !m_Candidates.empty() || m_Scanned < m_Total;
+            inRing = m_Total - oldest;
+        }
+
+        ImGui::SameLine();
+        if (filtering)
+            ImGui::TextDisabled("%zu of %llu (filtering...)", m_View.size(), (unsigned long long)inRing);
+        else
+            ImGui::TextDisabled("%zu of %llu", m_View.size(), (unsigned long long)inRing);
 
         ImGui::BeginChild(ICON_FK_LIST" Console", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar);
 
-        for (auto itr = m_Messages.begin(); itr != m_Messages.end(); ++itr)
+        // Only the rows on screen, whatever the size of the history
+        ImGuiListClipper clipper;
+        clipper.Begin((int)m_View.size());
+        while (clipper.Step())
         {
-            switch (itr->first)
             {
-                case Severity::Trace:
-                    if (m_TraceEnabled)
-                        ImGui::TextColored(m_TraceColor, (ICON_FK_PAPERCLIP" " + itr->second).c_str()); break;
-                case Severity::Info:
-                    if (m_InfoEnabled)
-                        ImGui::TextColored(m_InfoColor, (ICON_FK_INFO_CIRCLE" " + itr->second).c_str()); break;
-                case Severity::Debug:
-                    if (m_DebugEnabled)
-                        ImGui::TextColored(m_DebugColor, (ICON_FK_BUG" " + itr->second).c_str()); break;
-                case Severity::Warning:
-                    if (m_WarningEnabled)
-                        ImGui::TextColored(m_WarnColor, (ICON_FK_EXCLAMATION_TRIANGLE" " + itr->second).c_str()); break;
-                case Severity::Error:
-                    if (m_ErrorEnabled)
-                        ImGui::TextColored(m_ErrorColor, (ICON_FK_EXCLAMATION_CIRCLE" " + itr->second).c_str()); break;
-                case Severity::Critical:
-                    // You can't toggle off the critical errors!
-                    ImGui::TextColored(m_CriticalColor, (ICON_FK_EXCLAMATION_CIRCLE" " + itr->second).c_str()); break;
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                CopyRows(clipper.DisplayStart, clipper.DisplayEnd);
+            }
+
+            for (const ConsoleMessage& message : m_Rows)
+            {
+                const char* icon = ICON_FK_INFO_CIRCLE;
+                ImVec4 color = m_InfoColor;
+                switch (message.Level)
+                {
+                    case Severity::Trace:    icon = ICON_FK_PAPERCLIP; color = m_TraceColor; break;
+                    case Severity::Info:     icon = ICON_FK_INFO_CIRCLE; color = m_InfoColor; break;
+                    case Severity::Debug:    icon = ICON_FK_BUG; color = m_DebugColor; break;
+                    case Severity::Warning:  icon = ICON_FK_EXCLAMATION_TRIANGLE; color = m_WarnColor; break;
+                    case Severity::Error:    icon = ICON_FK_EXCLAMATION_CIRCLE; color = m_ErrorColor; break;
+                    case Severity::Critical: icon = ICON_FK_EXCLAMATION_CIRCLE; color = m_CriticalColor; break;
+                }
+
+                ImGui::PushStyleColor(ImGuiCol_Text, color);
+                ImGui::TextUnformatted(icon);
+                ImGui::SameLine();
+                ImGui::TextUnformatted(message.Text.data(), message.Text.data() + message.Text.size());
+                ImGui::PopStyleColor();
             }
         }
 
@@ -75,17 +146,205 @@ namespace Spike
 
         ImGui::EndChild();
         ImGui::End();
+    }
+
+    // Case insensitive (ASCII) substring search, about twice as fast as ImStristr over a million lines
+    static bool ContainsNoCase(const String& text, const String& search)
+    {
+        if (search.size() > text.size())
+            return false;
+
+        const char lower = (char)tolower((unsigned char)search[0]);
+        const char upper = (char)toupper((unsigned char)search[0]);
+        const char* last = text.data() + text.size() - search.size();
+        for (const char* c = text.data(); c <= last; c++)
+        {
+            if (*c != lower && *c != upper)
+                continue;
+
+            size_t i = 1;
+            while (i < search.size() && tolower((unsigned char)c[i]) == tolower((unsigned char)search[i]))
+                i++;
+            if (i == search.size())
+                return true;
+        }
+        return false;
+    }
+
+    bool Console::IsSeverityShown(Severity level) const
+    {
+        switch (level)
+        {
+            case Severity::Trace:    return m_TraceEnabled;
+            case Severity::Info:     return m_InfoEnabled;
+            case Severity::Debug:    return m_DebugEnabled;
+            case Severity::Warning:  return m_WarningEnabled;
+            case Severity::Error:    return m_ErrorEnabled;
+            case Severity::Critical: return true; // You can't toggle off the critical errors!
+        }
+        return true;
+    }
+
+    bool Console::Passes(uint64_t sequence) const
+    {
+        const ConsoleMessage& message = GetMessage(sequence);
+        if (!m_ShownSeverities[(Uint)message.Level])
+            return false;
+        if (m_Search.empty())
+            return true;
+
+        return ContainsNoCase(message.Text, m_Search);
+    }
+
+    /* [Spike] Doesn't filter anything itself, it only decides what Scan has to look at again. A search that got longer
+     * can only match fewer messages, so only the current matches are checked again, anything else starts over [Spike] */
+    void Console::ApplyFilter()
+    {
+        bool shown[SeverityCount];
+        for (Uint i = 0; i < SeverityCount; i++)
+            shown[i] = IsSeverityShown((Severity)i);
+
+        const String search = m_SearchBuffer;
+        const bool severitiesChanged = memcmp(shown, m_ShownSeverities, sizeof(shown)) != 0;
+        if (!severitiesChanged && search == m_Search)
+            return;
 
+        const bool narrower = !severitiesChanged && !m_Search.empty() && ContainsNoCase(search, m_Search);
+        memcpy(m_ShownSeverities, shown, sizeof(shown));
+        m_Search = search;
+
+        if (narrower)
+        {
+            // What already matched comes first, then what wasn't checked yet, both in order
+            std::deque<uint64_t> candidates = std::move(m_View);
+            candidates.insert(candidates.end(), m_Candidates.begin() + m_NextCandidate, m_Candidates.end());
+            m_Candidates = std::move(candidates);
+        }
+        else
+        {
+            // Only the shown severities, back in order. Without a search that's already the whole view
+            m_Candidates = MergeShownSeverities();
+            m_Scanned = m_Total;
+            if (m_Search.empty())
+            {
+                m_View = std::move(m_Candidates);
+                m_Candidates.clear();
+                m_NextCandidate = 0;
+                return;
+            }
+        }
+        m_View.clear();
+        m_NextCandidate = 0;
+    }
+
+    std::deque<uint64_t> Console::MergeShownSeverities() const
+    {
+        using Iterator = std::deque<uint64_t>::const_iterator;
+        Vector<std::pair<Iterator, Iterator>> sources;
+        for (Uint i = 0; i < SeverityCount; i++)
+        {
+            if (m_ShownSeverities[i] && !m_SeverityIndices[i].empty())
+                sources.emplace_back(m_SeverityIndices[i].begin(), m_SeverityIndices[i].end());
+        }
+
+        // Every index is in order already, so this only has to pick the smallest of at most SeverityCount fronts
+        std::deque<uint64_t> merged;
+        while (!sources.empty())
+        {
+            size_t smallest = 0;
+            for (size_t i = 1; i < sources.size(); i++)
+            {
+                if (*sources[i].first < *sources[smallest].first)
+                    smallest = i;
+            }
+            merged.push_back(*sources[smallest].first++);
+            if (sources[smallest].first == sources[smallest].second)
+                sources.erase(sources.begin() + smallest);
+        }
+        return merged;
+    }
+
+    void Console::Scan()
+    {
+        Clock clock;
+        auto outOfTime = [&](Uint checked)
+        {
+            // Reading the clock for every message would cost more than most checks
+            return (checked & 1023) == 0 && clock.GetElapsedTime().AsNanoseconds() / 1000000.0f > ScanBudget;
+        };
+
+        const uint64_t oldest = GetOldest();
+        Uint checked = 0;
+        while (m_NextCandidate < m_Candidates.size() && !outOfTime(++checked))
+        {
+            const uint64_t sequence = m_Candidates[m_NextCandidate++];
+            if (sequence >= oldest && Passes(sequence))
+                m_View.push_back(sequence);
+        }
+
+        // The view stays in order, newer messages wait until every candidate is through
+        if (m_NextCandidate < m_Candidates.size())
+            return;
+        m_Candidates.clear();
+        m_NextCandidate = 0;
+
+        m_Scanned = std::max(m_Scanned, oldest);
+        for (; m_Scanned < m_Total && !outOfTime(++checked); m_Scanned++)
+        {
+            if (Passes(m_Scanned))
+                m_View.push_back(m_Scanned);
+        }
     }
 
     void Console::Print(const String& message, Severity level)
     {
-        m_Messages.emplace_back(std::pair<Severity, String>(level, message));
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        const uint64_t sequence = m_Total++;
+        if (m_Messages.size() < Capacity)
+        {
+            m_Messages.push_back({ level, message });
+        }
+        else
+        {
+            // Overwrites the oldest message, which is also the first entry of its severity's index
+            ConsoleMessage& slot = m_Messages[sequence % Capacity];
+            m_SeverityIndices[(Uint)slot.Level].pop_front();
+            slot.Level = level;
+            slot.Text.assign(message);
+        }
+        m_SeverityIndices[(Uint)level].push_back(sequence);
+    }
+
+    void Console::CopyRows(int begin, int end)
+    {
+        // Messages overwritten since the view was trimmed are left empty, they are gone next frame
+        const uint64_t oldest = GetOldest();
+        m_Rows.resize(end - begin);
+        for (int row = begin; row < end; row++)
+        {
+            ConsoleMessage& copy = m_Rows[row - begin];
+            const uint64_t sequence = m_View[row];
+            if (sequence < oldest)
+            {
+                copy.Text.clear();
+                continue;
+            }
+
+            const ConsoleMessage& message = GetMessage(sequence);
+            copy.Level = message.Level;
+            copy.Text.assign(message.Text);
+        }
     }
 
     void Console::ClearLog()
     {
         m_Messages.clear();
+        m_Total = 0;
+        for (auto& indices : m_SeverityIndices)
+            indices.clear();
+        m_View.clear();
+        m_Candidates.clear();
+        m_NextCandidate = 0;
+        m_Scanned = 0;
     }
-
-}
\ No newline at end of file
+}
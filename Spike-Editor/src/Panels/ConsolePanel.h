@@ -3,16 +3,33 @@
 #pragma once
 #include "Spike/Core/Base.h"
 #include "Spike/Core/Log.h"
+#include "Spike/Utility/Clock.h"
 #include <imgui.h>
 #include <FontAwesome.h>
 #include <vector>
 #include <string>
+#include <deque>
+#include <mutex>
 
 namespace Spike
 {
+    struct ConsoleMessage
+    {
+        Severity Level = Severity::Info;
+        String Text;
+    };
+
+    /* [Spike] Keeps the last Capacity messages in a ring, the oldest are overwritten instead of the whole history being
+     * thrown away. Only the rows on screen are drawn, from copies, so Print is never held up by ImGui. Toggling a
+     * severity merges the per severity indices instead of looking at every message, a search is worked out a few
+     * milliseconds at a time, so neither a million lines nor a new filter make a frame longer than ScanBudget [Spike] */
     class Console
     {
     public:
+        static constexpr Uint Capacity = 1 << 20;
+        static constexpr float ScanBudget = 2.0f; // Milliseconds per frame the filter may take
+        static constexpr Uint SeverityCount = (Uint)Severity::Critical + 1;
+
         ~Console();
         static Console* Get();
         void OnImGuiRender(bool* show);
@@ -20,10 +37,35 @@ namespace Spike
 
     private:
         Console();
+
+        bool IsSeverityShown(Severity level) const;
+
+        // All of these expect m_Mutex to be held
         void ClearLog();
+        uint64_t GetOldest() const { return m_Total > Capacity ? m_Total - Capacity : 0; }
+        const ConsoleMessage& GetMessage(uint64_t sequence) const { return m_Messages[sequence % Capacity]; }
+        bool Passes(uint64_t sequence) const;
+        std::deque<uint64_t> MergeShownSeverities() const;
+        void ApplyFilter();
+        void Scan();
+        void CopyRows(int begin, int end);
     private:
         static Console* m_Console;
-        std::vector<std::pair<Severity, String>> m_Messages{};
+        std::mutex m_Mutex; // Print is called from the logging thread
+
+        Vector<ConsoleMessage> m_Messages; // Ring, grows up to Capacity
+        uint64_t m_Total = 0; // Messages ever printed, message n is m_Messages[n % Capacity] while n >= GetOldest()
+        std::deque<uint64_t> m_SeverityIndices[SeverityCount]; // Sequence numbers still in the ring, per severity
+
+        std::deque<uint64_t> m_View; // Sequence numbers that passed the filter, oldest first
+        std::deque<uint64_t> m_Candidates; // Still to be checked against the filter, all older than m_Scanned
+        size_t m_NextCandidate = 0;
+        uint64_t m_Scanned = 0; // Every message below this is in m_View, in m_Candidates or filtered out
+        Vector<ConsoleMessage> m_Rows; // Copies of the rows being drawn
+
+        char m_SearchBuffer[256] = "";
+        String m_Search; // What m_View is filtered by
+        bool m_ShownSeverities[SeverityCount] = {}; // What m_View is filtered by
         bool m_ScrollLockEnabled = true;
 
         //Colors
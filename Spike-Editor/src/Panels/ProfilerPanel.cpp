@@ -3,6 +3,11 @@
 #include "spkpch.h"
 #include "ProfilerPanel.h"
 #include "Spike/Core/Application.h"
+#include "Spike/Core/JobSystem.h"
+#include "Spike/Core/FrameAllocator.h"
+#include "Spike/Core/MemoryTracker.h"
+#include "Spike/Core/ObjectPool.h"
+#include "Spike/Core/Profiler.h"
 #include "Spike/Renderer/Renderer.h"
 #include "Spike/Renderer/Renderer2D.h"
 #include "UIUtils/UIUtils.h"
@@ -10,35 +15,13 @@
 
 namespace Spike
 {
-    void ProfilerPanel::OnImGuiRender(bool* show)
+    void ProfilerPanel::OnImGuiRender(bool* show, const Ref<Scene>& scene)
     {
-        float avg = 0.0f;
-        const uint32_t size = m_FrameTimes.size();
-        if (size >= 50)
-            m_FrameTimes.erase(m_FrameTimes.begin());
-
-        m_FrameTimes.push_back(ImGui::GetIO().Framerate);
-        for (uint32_t i = 0; i < size; i++)
-        {
-            m_FPSValues[i] = m_FrameTimes[i];
-            avg += m_FrameTimes[i];
-        }
-        avg /= size;
-
         ImGui::Begin("Profiler", show);
         auto& caps = RendererAPI::GetCapabilities();
         ImGui::Text("Vendor: %s", caps.Vendor.c_str());
         ImGui::Text("Renderer: %s", caps.Renderer.c_str());
-        const float fps = (1.0f / avg) * 1000.0f;
-        ImGui::Text("Frame time (ms): %f", fps);
-
-        ImGui::Text("FPS: %f", avg);
-        ImGui::SameLine();
-        ImGui::Columns(2);
-        ImGui::NextColumn();
-        ImGui::SetColumnWidth(0, 130.0f);
-        ImGui::PlotHistogram("##FPS", m_FPSValues, size);
-        ImGui::Columns(1);
+        DrawFrameStats();
         m_VSync = Application::Get().GetWindow().IsVSync();
         if (GUI::DrawBoolControl("VSync Enabled", &m_VSync, 130.0f))
             Application::Get().GetWindow().SetVSync(m_VSync);
@@ -52,7 +35,273 @@ namespace Spike
         ImGui::Text("Quad Count: %d", stats2D.QuadCount);
         ImGui::Text("Vertices: %d", stats2D.GetTotalVertexCount());
         ImGui::Text("Indices: %d", stats2D.GetTotalIndexCount());
+        ImGui::Text("Uploaded: %.2f KB", stats2D.UploadedBytes / 1024.0f);
+        ImGui::Text("Texture Slot Flushes: %d", stats2D.TextureSlotFlushes);
+        ImGui::Text("Sprites Drawn: %d", stats2D.SpritesDrawn);
+        ImGui::Text("Sprites Culled: %d", stats2D.SpritesCulled);
+        ImGui::Text("Static Chunks: %d drawn, %d rebaked", stats2D.StaticChunksDrawn, stats2D.StaticChunksRebaked);
+        ImGui::Text("Mode: %s", Renderer2D::GetRenderMode() == Renderer2D::SpriteRenderMode::Instanced ? "Instanced" : "Batched");
+        ImGui::Text("Quad Emitter: %s", Renderer2D::GetQuadEmitterName());
+        const char* sortModes[] = { "None", "Layered", "Opaque Only" };
+        int sortMode = (int)Renderer2D::GetSortMode();
+        if (ImGui::Combo("Sprite Sorting", &sortMode, sortModes, IM_ARRAYSIZE(sortModes)))
+            Renderer2D::SetSortMode((Renderer2D::SpriteSortMode)sortMode);
+        if (ImGui::Button("Benchmark Quad Emitters"))
+            m_EmitterBenchmark = Renderer2D::BenchmarkQuadEmitters();
+        if (m_EmitterBenchmark.QuadCount)
+        {
+            ImGui::Text("Scalar: %.2f M quads/s", m_EmitterBenchmark.ScalarQuadsPerSecond / 1000000.0);
+            if (m_EmitterBenchmark.AVX2QuadsPerSecond > 0.0)
+                ImGui::Text("AVX2: %.2f M quads/s", m_EmitterBenchmark.AVX2QuadsPerSecond / 1000000.0);
+            else
+                ImGui::TextDisabled("AVX2: not supported on this CPU");
+        }
+        ImGui::Separator();
+        ImGui::Text("Job System");
+        ImGui::Text("Worker Threads: %d", JobSystem::GetWorkerCount());
+        if (ImGui::Button("Benchmark Job Scheduling"))
+            m_JobBenchmark = JobSystem::BenchmarkScheduling();
+        if (m_JobBenchmark.JobCount)
+        {
+            ImGui::Text("%d empty jobs on %d threads", m_JobBenchmark.JobCount, m_JobBenchmark.ThreadCount);
+            ImGui::Text("Job System: %.2f ms", m_JobBenchmark.JobSystemMilliseconds);
+            ImGui::Text("Naive Pool: %.2f ms", m_JobBenchmark.NaivePoolMilliseconds);
+        }
+
+        ImGui::Separator();
+        const FrameAllocatorStats frameMemory = FrameAllocator::GetStats();
+        ImGui::Text("Frame Allocator");
+        ImGui::Text("Last Frame: %.2f KB / %.2f KB", frameMemory.UsedLastFrame / 1024.0f, frameMemory.Capacity / 1024.0f);
+        ImGui::Text("Peak: %.2f KB", frameMemory.PeakUsed / 1024.0f);
+        if (frameMemory.OverflowLastFrame)
+            ImGui::TextColored({ 1.0f, 0.4f, 0.4f, 1.0f }, "Overflow: %.2f KB", frameMemory.OverflowLastFrame / 1024.0f);
+
+        ImGui::Separator();
+        ImGui::Text("Heap (%s)", MemoryTracker::IsEnabled() ? "tracked" : "tracking compiled out, enable SPK_TRACK_MEMORY");
+        if (MemoryTracker::IsEnabled() && ImGui::BeginTable("MemoryTags", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        {
+            ImGui::TableSetupColumn("Tag");
+            ImGui::TableSetupColumn("Live KB");
+            ImGui::TableSetupColumn("Peak KB");
+            ImGui::TableSetupColumn("Allocs/Frame");
+            ImGui::TableSetupColumn("KB/Frame");
+            ImGui::TableHeadersRow();
+
+            const MemoryStats memory = MemoryTracker::GetStats();
+            for (size_t tag = 0; tag < memory.size(); tag++)
+            {
+                const MemoryTagStats& stats = memory[tag];
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(MemoryTracker::GetTagName((MemoryTag)tag));
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", stats.LiveBytes / 1024.0f);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", stats.PeakLiveBytes / 1024.0f);
+                ImGui::TableNextColumn(); ImGui::Text("%lld", (long long)stats.AllocationsLastFrame);
+                ImGui::TableNextColumn(); ImGui::Text("%.1f", stats.BytesLastFrame / 1024.0f);
+            }
+            ImGui::EndTable();
+        }
+        if (ImGui::Button("Dump Memory Report"))
+        {
+            const char* path = "Logs/SpikeEngine-Memory.txt";
+            if (MemoryTracker::DumpToFile(path))
+                SPK_CORE_LOG_INFO("Memory report written to %s", path);
+            else
+                SPK_CORE_LOG_ERROR("Failed to write the memory report to %s", path);
+        }
+
+        ImGui::Separator();
+        ImGui::Text("Object Pools");
+        for (const ObjectPoolStats& pool : ObjectPool::GetAllStats())
+        {
+            ImGui::Text("%s: %d live (peak %d), %.2f KB / %.2f KB", pool.TypeName, pool.LiveObjects, pool.HighWaterMark,
+                pool.LiveBytes / 1024.0f, pool.ReservedBytes / 1024.0f);
+        }
+        if (ImGui::Button("Benchmark Ref Counting"))
+            m_RefCountBenchmark = BenchmarkRefCounting();
+        if (m_RefCountBenchmark.Iterations)
+        {
+            ImGui::Text("%d submissions", m_RefCountBenchmark.Iterations);
+            ImGui::Text("Plain count, by value: %.2f ms", m_RefCountBenchmark.PlainByValueMilliseconds);
+            ImGui::Text("Atomic count, by value: %.2f ms", m_RefCountBenchmark.AtomicByValueMilliseconds);
+            ImGui::Text("Atomic count, by reference: %.2f ms", m_RefCountBenchmark.AtomicByReferenceMilliseconds);
+        }
+
+        const TaskGraph* graph = scene ? scene->GetFrameGraph() : nullptr;
+        if (graph)
+        {
+            ImGui::Separator();
+            ImGui::Text("Task Graph (%s): %.3f ms, critical path %.3f ms", graph->GetName().c_str(), graph->GetFrameMilliseconds(), graph->GetCriticalPathMilliseconds());
+            for (auto& task : graph->GetTaskStats())
+            {
+                ImVec4 color = task.OnCriticalPath ? ImVec4(1.0f, 0.6f, 0.2f, 1.0f) : ImGui::GetStyleColorVec4(ImGuiCol_Text);
+                ImGui::TextColored(color, "%s%s: %.3f ms (at %.3f ms)", task.Name, task.MainThread ? " [main]" : "", task.Milliseconds, task.StartMilliseconds);
+            }
+            if (ImGui::Button("Dump Task Graph"))
+            {
+                String dump = graph->Dump();
+                SPK_CORE_LOG_INFO("%s", dump.c_str());
+                ImGui::SetClipboardText(dump.c_str());
+            }
+        }
+
+        ImGui::Separator();
+        DrawFlameView();
         ImGui::End();
     }
 
+    void ProfilerPanel::DrawFrameStats()
+    {
+        const Uint plotFrames = std::min(FrameStats::GetFrameCount(), PlotFrameCount);
+        for (Uint i = 0; i < plotFrames; i++)
+            m_FramePlot[i] = FrameStats::GetFrameTime(plotFrames - 1 - i);
+
+        const float lastFrame = FrameStats::GetFrameTime(0);
+        const float averageFPS = ImGui::GetIO().Framerate;
+        ImGui::Text("Frame time: %.3f ms (average %.3f ms, %.1f FPS)", lastFrame, averageFPS > 0.0f ? 1000.0f / averageFPS : 0.0f, averageFPS);
+        ImGui::PlotLines("##FrameTimes", m_FramePlot, (int)plotFrames, 0, nullptr, 0.0f, FLT_MAX, { ImGui::GetContentRegionAvail().x, 60.0f });
+
+        // Sorting every sample of every system is too much for every frame
+        if (m_FramesSinceReport++ % 30 == 0)
+            m_FrameReport = FrameStats::GetReport();
+
+        if (!ImGui::CollapsingHeader("Frame Statistics"))
+            return;
+
+        float threshold = FrameStats::GetHitchThreshold();
+        ImGui::SetNextItemWidth(150.0f);
+        if (ImGui::DragFloat("Hitch Threshold (ms)", &threshold, 0.1f, 1.0f, 1000.0f, "%.1f"))
+        {
+            FrameStats::SetHitchThreshold(threshold);
+            m_FrameReport = FrameStats::GetReport();
+        }
+        ImGui::Text("Hitches: %u of the last %u frames", m_FrameReport.HitchCount, m_FrameReport.FrameCount);
+
+        if (ImGui::BeginTable("FrameStats", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        {
+            ImGui::TableSetupColumn("System (ms)");
+            ImGui::TableSetupColumn("Mean");
+            ImGui::TableSetupColumn("p50");
+            ImGui::TableSetupColumn("p95");
+            ImGui::TableSetupColumn("p99");
+            ImGui::TableSetupColumn("Max");
+            ImGui::TableHeadersRow();
+
+            auto row = [](const FrameTimeSummary& summary)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(summary.Name ? summary.Name : "Frame");
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", summary.Mean);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", summary.P50);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", summary.P95);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", summary.P99);
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", summary.Max);
+            };
+            row(m_FrameReport.Frame);
+            for (const FrameTimeSummary& system : m_FrameReport.Systems)
+                row(system);
+            ImGui::EndTable();
+        }
+
+        if (ImGui::Button("Reset"))
+        {
+            FrameStats::Reset();
+            m_FrameReport = FrameStats::GetReport();
+        }
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(150.0f);
+        ImGui::InputText("Label", m_ExportLabel, sizeof(m_ExportLabel));
+        ImGui::SameLine();
+        if (ImGui::Button("Export CSV"))
+        {
+            const char* path = "Logs/SpikeEngine-FrameStats.csv";
+            if (FrameStats::ExportCSV(path))
+                SPK_CORE_LOG_INFO("Frame statistics written to %s", path);
+            else
+                SPK_CORE_LOG_ERROR("Failed to write the frame statistics to %s", path);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Export JSON"))
+        {
+            const char* path = "Logs/SpikeEngine-FrameStats.json";
+            if (FrameStats::ExportJSON(path, m_ExportLabel))
+                SPK_CORE_LOG_INFO("Frame statistics written to %s", path);
+            else
+                SPK_CORE_LOG_ERROR("Failed to write the frame statistics to %s", path);
+        }
+    }
+
+    void ProfilerPanel::DrawFlameView()
+    {
+        if (!Profiler::IsEnabled())
+        {
+            ImGui::TextDisabled("Scope profiling is compiled out in this configuration");
+            return;
+        }
+        if (!ImGui::CollapsingHeader("Flame View", ImGuiTreeNodeFlags_DefaultOpen))
+            return;
+
+        ImGui::SetNextItemWidth(150.0f);
+        ImGui::SliderInt("Frames", &m_ProfileFrames, 1, 16);
+        ImGui::SameLine();
+        ImGui::Checkbox("Pause", &m_ProfilePaused);
+        ImGui::SameLine();
+        if (ImGui::Button("Export Chrome Trace"))
+        {
+            const char* path = "Logs/SpikeEngine-Trace.json";
+            if (Profiler::ExportChromeTrace(path))
+                SPK_CORE_LOG_INFO("Trace of the last %u frames written to %s", Profiler::MaxCapturedFrames, path);
+            else
+                SPK_CORE_LOG_ERROR("Failed to write the trace to %s", path);
+        }
+
+        if (!m_ProfilePaused)
+            m_ProfileCapture = Profiler::Capture((Uint)m_ProfileFrames);
+
+        const ProfileCapture& capture = m_ProfileCapture;
+        ImGui::Text("%.3f ms over %d frames", capture.GetMilliseconds(), (int)capture.FrameEnds.size());
+        if (capture.End <= capture.Start)
+            return;
+
+        const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+        const float width = std::max(ImGui::GetContentRegionAvail().x, 100.0f);
+        const double nanosecondsToPixels = width / (double)(capture.End - capture.Start);
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+        for (const ProfileThreadCapture& thread : capture.Threads)
+        {
+            ImGui::TextUnformatted(thread.Name.c_str());
+            const ImVec2 origin = ImGui::GetCursorScreenPos();
+            const float height = (thread.MaxDepth + 1) * rowHeight;
+            ImGui::InvisibleButton(thread.Name.c_str(), { width, height });
+            drawList->AddRectFilled(origin, { origin.x + width, origin.y + height }, IM_COL32(30, 30, 30, 255));
+
+            for (const ProfileScopeRecord& scope : thread.Scopes)
+            {
+                const ImVec2 min = { origin.x + (float)((scope.Start - capture.Start) * nanosecondsToPixels), origin.y + scope.Depth * rowHeight };
+                const ImVec2 max = { std::max(origin.x + (float)((scope.End - capture.Start) * nanosecondsToPixels), min.x + 1.0f), min.y + rowHeight - 1.0f };
+
+                // Same name, same color, every frame
+                const float hue = (float)(std::hash<const void*>()(scope.Name) % 360) / 360.0f;
+                ImVec4 color;
+                ImGui::ColorConvertHSVtoRGB(hue, 0.5f, 0.8f, color.x, color.y, color.z);
+                drawList->AddRectFilled(min, max, ImGui::ColorConvertFloat4ToU32({ color.x, color.y, color.z, 1.0f }));
+
+                if (max.x - min.x > 20.0f)
+                {
+                    drawList->PushClipRect(min, max, true);
+                    drawList->AddText({ min.x + 2.0f, min.y }, IM_COL32(0, 0, 0, 255), scope.Name);
+                    drawList->PopClipRect();
+                }
+                if (ImGui::IsMouseHoveringRect(min, max))
+                    ImGui::SetTooltip("%s\n%.3f ms", scope.Name, (scope.End - scope.Start) / 1000000.0f);
+            }
+
+            for (int64_t frameEnd : capture.FrameEnds)
+            {
+                const float x = origin.x + (float)((frameEnd - capture.Start) * nanosecondsToPixels);
+                drawList->AddLine({ x, origin.y }, { x, origin.y + height }, IM_COL32(255, 255, 255, 120));
+            }
+        }
+    }
+
 }
\ No newline at end of file
@@ -1,7 +1,11 @@
 //                    SPIKE ENGINE
 //Copyright 2021 - SpikeTechnologies - All Rights Reserved
 #pragma once
-#include <vector>
+#include "Spike/Renderer/Renderer2D.h"
+#include "Spike/Core/JobSystem.h"
+#include "Spike/Core/Profiler.h"
+#include "Spike/Core/FrameStats.h"
+#include "Spike/Scene/Scene.h"
 
 namespace Spike
 {
@@ -9,12 +13,24 @@ namespace Spike
     class ProfilerPanel
     {
     public:
-        void OnImGuiRender(bool* show);
+        void OnImGuiRender(bool* show, const Ref<Scene>& scene);
 
     private:
-        float m_Time = 0.0f;
+        void DrawFrameStats();
+        void DrawFlameView();
+    private:
+        static constexpr Uint PlotFrameCount = 300;
+
         bool m_VSync;
-        float m_FPSValues[50];
-        std::vector<float> m_FrameTimes;
+        float m_FramePlot[PlotFrameCount];
+        FrameStatsReport m_FrameReport;
+        Uint m_FramesSinceReport = 0;
+        char m_ExportLabel[64] = "";
+        Renderer2D::QuadEmitterBenchmark m_EmitterBenchmark;
+        JobSystemBenchmark m_JobBenchmark;
+        RefCountBenchmark m_RefCountBenchmark;
+        ProfileCapture m_ProfileCapture;
+        int m_ProfileFrames = 4;
+        bool m_ProfilePaused = false;
     };
 }
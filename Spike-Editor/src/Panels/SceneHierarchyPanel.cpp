@@ -132,7 +132,8 @@ namespace Spike
         m_Context->m_Registry.each([&](auto entityID)
         {
             Entity entity{ entityID, m_Context.Raw() };
-            if (entity.HasComponent<IDComponent>())
+            // Children are drawn by their parent's node
+            if (entity.HasComponent<IDComponent>() && !m_Context->GetParent(entity))
                 DrawEntityNode(entity);
         });
 
@@ -155,18 +156,43 @@ namespace Spike
     void SceneHierarchyPanel::DrawEntityNode(Entity entity)
     {
         auto& tag = entity.GetComponent<TagComponent>().Tag;
+        auto children = m_Context->GetChildren(entity);
 
         ImGuiTreeNodeFlags flags = ((m_SelectionContext == entity) ? ImGuiTreeNodeFlags_Selected : 0) | ImGuiTreeNodeFlags_OpenOnArrow;
         flags |= ImGuiTreeNodeFlags_SpanAvailWidth;
+        if (children.empty())
+            flags |= ImGuiTreeNodeFlags_Leaf;
 
         bool opened = ImGui::TreeNodeEx((void*)(uint64_t)(uint32_t)entity, flags, tag.c_str());
 
         if (ImGui::IsItemClicked())
             m_SelectionContext = entity;
 
+        if (ImGui::BeginDragDropSource())
+        {
+            UUID entityID = entity.GetUUID();
+            ImGui::SetDragDropPayload("SPK_ENTITY", &entityID, sizeof(UUID));
+            ImGui::TextUnformatted(tag.c_str());
+            ImGui::EndDragDropSource();
+        }
+
+        if (ImGui::BeginDragDropTarget())
+        {
+            if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("SPK_ENTITY"))
+            {
+                UUID droppedID = *(const UUID*)payload->Data;
+                auto& entityMap = m_Context->m_EntityIDMap;
+                if (entityMap.find(droppedID) != entityMap.end() && entityMap.at(droppedID) != entity)
+                    m_Context->SetParent(entityMap.at(droppedID), entity);
+            }
+            ImGui::EndDragDropTarget();
+        }
+
         bool entityDeleted = false;
         if (ImGui::BeginPopupContextItem())
         {
+            if (m_Context->GetParent(entity) && ImGui::MenuItem("Unparent Entity"))
+                m_Context->SetParent(entity, {});
             if (ImGui::MenuItem("Delete Entity"))
                 entityDeleted = true;
 
@@ -174,13 +200,17 @@ namespace Spike
         }
 
         if (opened)
+        {
+            for (auto& child : children)
+                DrawEntityNode(child);
             ImGui::TreePop();
+        }
 
         if (entityDeleted)
         {
-            m_Context->DestroyEntity(entity);
-            if (m_SelectionContext == entity)
+            if (m_SelectionContext && (m_SelectionContext == entity || m_Context->IsDescendantOf(m_SelectionContext, entity)))
                 m_SelectionContext = {};
+            m_Context->DestroyEntity(entity);
         }
 
     }
@@ -318,6 +348,12 @@ namespace Spike
 
             // Tiling Factor
             GUI::DrawFloatControl("Tiling Factor", &component.TilingFactor, 100);
+
+            if (GUI::DrawIntControl("Sorting Layer", &component.SortingLayer, 100))
+                component.SortingLayer = glm::clamp(component.SortingLayer, -128, 127);
+            if (GUI::DrawIntControl("Order In Layer", &component.OrderInLayer, 100))
+                component.OrderInLayer = glm::clamp(component.OrderInLayer, -2048, 2047);
+            GUI::DrawBoolControl("Static", &component.Static, 100);
         });
 
         DrawComponent<MeshComponent>(ICON_FK_CUBE" Mesh", entity, [](auto& component)
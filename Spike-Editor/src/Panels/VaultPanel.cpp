@@ -99,7 +99,7 @@ namespace Spike
         ImGui::Begin("SpikeCache", show);
         if (ImGui::TreeNode("Shaders"))
         {
-            auto& shaders = Vault::GetAllShaders();
+            const auto& shaders = Vault::GetAllShaders();
             for (auto& shader : shaders)
                 if (shader)
                     if (ImGui::TreeNode(shader->GetName().c_str()))
@@ -108,7 +108,7 @@ namespace Spike
         }
         if (ImGui::TreeNode("Textures"))
         {
-            auto& textures = Vault::GetAllTextures();
+            const auto& textures = Vault::GetAllTextures();
             for (auto& texture : textures)
                 if (texture)
                     if (ImGui::TreeNode(texture->GetName().c_str()))
@@ -117,10 +117,10 @@ namespace Spike
         }
         if (ImGui::TreeNode("Scripts"))
         {
-            auto& scripts = Vault::GetAllScripts();
+            const auto& scripts = Vault::GetAllScripts();
             for (auto& script : scripts)
-                if (script.first.c_str())
-                    if (ImGui::TreeNode(Vault::GetNameWithExtension(script.first).c_str()))
+                if (script.c_str())
+                    if (ImGui::TreeNode(Vault::GetNameWithExtension(script).c_str()))
                         ImGui::TreePop();
             ImGui::TreePop();
         }
@@ -0,0 +1,83 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "Spike/Core/BinaryLog.h"
+#include "Spike/Core/LogRingFile.h"
+#include "Spike/Core/MappedFile.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+/* [Spike] Turns a binary or ring .spikeLog back into the text a text log would have had, plus the date, the
+ * milliseconds and the thread. Ring files come out oldest message first. Usage: SpikeLogDecoder <log.spikeLog>
+ * [output.txt], without an output it prints [Spike] */
+
+using namespace Spike;
+
+static void WriteMessage(FILE* output, const BinaryLogMessage& message, String& text)
+{
+    const std::time_t seconds = (std::time_t)(message.Timestamp / 1000000000);
+    const int milliseconds = (int)((message.Timestamp / 1000000) % 1000);
+    char time[32] = "";
+    std::strftime(time, sizeof(time), "%Y-%m-%d %H:%M:%S", std::localtime(&seconds));
+
+    text.clear();
+    BinaryLog::FormatArguments(message.Format, message.Arguments, text);
+
+    const char* line = text.c_str();
+    const char* end = line + text.size();
+    do
+    {
+        const char* lineEnd = (const char*)memchr(line, '\n', (size_t)(end - line));
+        if (!lineEnd)
+            lineEnd = end;
+        fprintf(output, "[%s][%s.%03d][T%u] %s: %.*s\n", message.Name, time, milliseconds, message.ThreadID,
+            Logger::GetSeverityID(message.Level), (int)(lineEnd - line), line);
+        line = lineEnd + 1;
+    } while (line < end);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "Usage: %s <log.spikeLog> [output.txt]\n", argv[0]);
+        return 1;
+    }
+
+    MappedFile file(argv[1], FileAccessHint::Sequential);
+    if (!file)
+    {
+        fprintf(stderr, "Failed to open %s\n", argv[1]);
+        return 1;
+    }
+
+    FILE* output = argc > 2 ? fopen(argv[2], "w") : stdout;
+    if (!output)
+    {
+        fprintf(stderr, "Failed to open %s for writing\n", argv[2]);
+        return 1;
+    }
+
+    // Text logs are already readable, pass them through so the tool works on any .spikeLog
+    bool succeeded = true;
+    String text;
+    if (LogRingFile::IsRingFile(file))
+    {
+        succeeded = LogRingFile::Decode(file, [&](const BinaryLogMessage& message) { WriteMessage(output, message, text); });
+        if (!succeeded)
+            fprintf(stderr, "%s is a ring file of another version or cut short\n", argv[1]);
+    }
+    else if (!BinaryLog::IsBinaryLog(file))
+        fwrite(file.GetData(), 1, (size_t)file.GetSize(), output);
+    else
+    {
+        succeeded = BinaryLog::Decode(file, [&](const BinaryLogMessage& message) { WriteMessage(output, message, text); });
+        if (!succeeded)
+            fprintf(stderr, "%s ends in a broken chunk (the process probably died while writing), everything before it was decoded\n", argv[1]);
+    }
+
+    if (output != stdout)
+        fclose(output);
+    return succeeded ? 0 : 2;
+}
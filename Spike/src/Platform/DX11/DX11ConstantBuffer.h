@@ -27,4 +27,6 @@ namespace Spike
         ShaderDomain m_ShaderDomain;
         DataUsage mDataUsage;
     };
+
+    SPK_POOL_ALLOCATE(DX11ConstantBuffer);
 }
@@ -44,7 +44,9 @@ namespace Spike
     DX11Pipeline::DX11Pipeline(const PipelineSpecification& spec)
         :m_Spec(spec)
     {
-        auto& elements = m_Spec.VertexBuffer->GetLayout().GetElements();
+        auto& layout = m_Spec.VertexBuffer->GetLayout();
+        auto& elements = layout.GetElements();
+        const bool perInstance = layout.GetInputRate() == VertexInputRate::PerInstance;
         D3D11_INPUT_ELEMENT_DESC* ied = new D3D11_INPUT_ELEMENT_DESC[elements.size()];
 
         for (int i = 0; i < elements.size(); i++)
@@ -52,7 +54,8 @@ namespace Spike
             auto& element = elements[i];
             ied[i] =
             {
-                element.Name.c_str(), 0, ShaderDataTypeToDirectXBaseType(element.Type), 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0
+                element.Name.c_str(), 0, ShaderDataTypeToDirectXBaseType(element.Type), 0, D3D11_APPEND_ALIGNED_ELEMENT,
+                perInstance ? D3D11_INPUT_PER_INSTANCE_DATA : D3D11_INPUT_PER_VERTEX_DATA, perInstance ? 1u : 0u
             };
         }
 
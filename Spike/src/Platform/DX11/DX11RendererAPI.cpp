@@ -42,6 +42,11 @@ namespace Spike
         DX11Internal::GetDeviceContext()->DrawIndexed(indexCount, baseIndex, baseVertex);
     }
 
+    void DX11RendererAPI::DrawIndexedInstanced(Ref<Pipeline>& pipeline, Uint indexCount, Uint instanceCount)
+    {
+        DX11Internal::GetDeviceContext()->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, 0);
+    }
+
     void DX11RendererAPI::BindBackbuffer()
     {
         DX11Internal::BindBackbuffer();
@@ -4,6 +4,7 @@
 #include "DX11Shader.h"
 #include "DX11Internal.h"
 #include "Spike/Core/Vault.h"
+#include "Spike/Core/Profiler.h"
 #include <d3dcompiler.h>
 
 namespace Spike
@@ -39,8 +40,8 @@ namespace Spike
         :m_Filepath(filepath)
     {
         m_Name = Vault::GetNameWithExtension(filepath);
-        String source = Vault::ReadFile(filepath);
-        m_ShaderSources = PreProcess(source);
+        MappedFile source = Vault::MapFile(filepath);
+        m_ShaderSources = PreProcess(source.GetString());
         Compile();
 
         auto device = DX11Internal::GetDevice();
@@ -118,31 +119,32 @@ namespace Spike
         return this;
     }
 
-    std::unordered_map<D3D11_SHADER_TYPE, String> DX11Shader::PreProcess(const String& source)
+    std::unordered_map<D3D11_SHADER_TYPE, String> DX11Shader::PreProcess(std::string_view source)
     {
         std::unordered_map<D3D11_SHADER_TYPE, String> shaderSources;
         const char* typeToken = "#type";
         size_t typeTokenLength = strlen(typeToken);
         size_t pos = source.find(typeToken, 0); //Start of shader type declaration line
 
-        while (pos != String::npos)
+        while (pos != std::string_view::npos)
         {
             size_t eol = source.find_first_of("\r\n", pos); //End of shader type declaration line
-            SPK_CORE_ASSERT(eol != String::npos, "Syntax error");
+            SPK_CORE_ASSERT(eol != std::string_view::npos, "Syntax error");
             size_t being = pos + typeTokenLength + 1; //Start of shader type name(after "#type " keyword)
-            String type = source.substr(being, eol - being);
+            String type = String(source.substr(being, eol - being));
             SPK_CORE_ASSERT(ShaderTypeFromString(type), "Invalid shader type specified");
 
             size_t nextLinePos = source.find_first_not_of("\r\n", eol); //Start of shader code after shader type declaration line
-            SPK_CORE_ASSERT(nextLinePos != String::npos, "Syntax error");
+            SPK_CORE_ASSERT(nextLinePos != std::string_view::npos, "Syntax error");
             pos = source.find(typeToken, nextLinePos); //Start of next shader type declaration line
-            shaderSources[ShaderTypeFromString(type)] = (pos == String::npos) ? source.substr(nextLinePos) : source.substr(nextLinePos, pos - nextLinePos);
+            shaderSources[ShaderTypeFromString(type)] = String((pos == std::string_view::npos) ? source.substr(nextLinePos) : source.substr(nextLinePos, pos - nextLinePos));
         }
         return shaderSources;
     }
 
     void DX11Shader::Compile()
     {
+        SPK_PROFILE_FUNCTION();
         HRESULT result;
         ID3DBlob* errorRaw = nullptr;
         UINT flags = D3DCOMPILE_ENABLE_STRICTNESS;
@@ -5,6 +5,7 @@
 #include <d3d11.h>
 #include <d3d11shader.h>
 #include <d3d11shadertracing.h>
+#include <string_view>
 
 namespace Spike
 {
@@ -35,7 +36,7 @@ namespace Spike
         ID3DBlob* GetPSRaw() { return m_RawBlobs.at(D3D11_PIXEL_SHADER); }
 
     private:
-        std::unordered_map<D3D11_SHADER_TYPE, String> PreProcess(const String& source);
+        std::unordered_map<D3D11_SHADER_TYPE, String> PreProcess(std::string_view source);
         void Compile();
 
     private:
@@ -5,6 +5,7 @@
 #include "Spike/Core/Vault.h"
 #include "DX11Texture.h"
 #include "DX11Internal.h"
+#include "Spike/Core/Profiler.h"
 #include <stb_image.h>
 
 namespace Spike
@@ -37,12 +38,12 @@ namespace Spike
         LoadTexture(flipped);
     }
 
-    void DX11Texture2D::SetData(void* data, Uint size)
+    void DX11Texture2D::SetData(BufferView data)
     {
         ID3D11DeviceContext* deviceContext = DX11Internal::GetDeviceContext();
         D3D11_MAPPED_SUBRESOURCE ms = {};
         deviceContext->Map(m_Texture2D, NULL, D3D11_MAP_WRITE_DISCARD, NULL, &ms);
-        memcpy(ms.pData, data, size);
+        memcpy(ms.pData, data.Data, (size_t)data.Size);
         deviceContext->Unmap(m_Texture2D, NULL);
     }
 
@@ -69,6 +70,7 @@ namespace Spike
 
     void DX11Texture2D::Reload(bool flip)
     {
+        SPK_PROFILE_FUNCTION();
         LoadTexture(flip);
     }
 
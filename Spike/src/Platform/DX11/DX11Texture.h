@@ -19,7 +19,7 @@ namespace Spike
         virtual Uint GetHeight() const override { return m_Height; }
         virtual String GetFilepath() const override { return m_Filepath; }
         virtual RendererID GetRendererID() const override { return (RendererID)m_SRV; }
-        virtual void SetData(void* data, Uint size) override;
+        virtual void SetData(BufferView data) override;
         virtual bool Loaded() override { return m_Loaded; };
         virtual void Reload(bool flip = false);
         virtual void Unbind() const override {}
@@ -50,7 +50,7 @@ namespace Spike
         virtual RendererID GetRendererID() const override { return m_RendererID; }
         virtual bool Loaded() override { return m_Loaded; }
         virtual void Reload(bool flip = false) override;
-        virtual void SetData(void* data, Uint size) override {}
+        virtual void SetData(BufferView data) override {}
         virtual void Unbind() const override {}
         virtual bool operator ==(const Texture& other) const override { return m_RendererID == ((DX11TextureCube&)other).m_RendererID; }
     private:
@@ -66,4 +66,5 @@ namespace Spike
         ID3D11ShaderResourceView* m_SRV;
     };
 
+    SPK_POOL_ALLOCATE(DX11Texture2D);
 }
@@ -21,19 +21,19 @@ namespace Spike
         DX_CALL(DX11Internal::GetDevice()->CreateBuffer(&vbd, nullptr, &mVertexBuffer)); //Create empty vertex buffer
     }
 
-    DX11VertexBuffer::DX11VertexBuffer(void* vertices, Uint size, VertexBufferLayout layout)
+    DX11VertexBuffer::DX11VertexBuffer(BufferView vertices, VertexBufferLayout layout)
         :mLayout(layout)
     {
         D3D11_BUFFER_DESC vbd = {};
         vbd.Usage = D3D11_USAGE_DEFAULT;
-        vbd.ByteWidth = size;
+        vbd.ByteWidth = (UINT)vertices.Size;
         vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
         vbd.CPUAccessFlags = 0;
         vbd.MiscFlags = 0;
         vbd.StructureByteStride = layout.GetStride();
 
         D3D11_SUBRESOURCE_DATA sd = {};
-        sd.pSysMem = vertices;
+        sd.pSysMem = vertices.Data;
         sd.SysMemPitch = 0;
         sd.SysMemSlicePitch = 0;
 
@@ -57,13 +57,13 @@ namespace Spike
         DX11Internal::GetDeviceContext()->IASetVertexBuffers(0, 1, nullptr, 0, 0);
     }
 
-    void DX11VertexBuffer::SetData(const void* data, Uint size)
+    void DX11VertexBuffer::SetData(BufferView data)
     {
         this->Bind();
         auto deviceContext = DX11Internal::GetDeviceContext();
         D3D11_MAPPED_SUBRESOURCE ms = {};
         deviceContext->Map(mVertexBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &ms);
-        memcpy(ms.pData, data, size);
+        memcpy(ms.pData, data.Data, (size_t)data.Size);
         deviceContext->Unmap(mVertexBuffer, 0);
         this->Bind();
     }
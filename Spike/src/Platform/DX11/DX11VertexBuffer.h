@@ -11,11 +11,11 @@ namespace Spike
     {
     public:
         DX11VertexBuffer(Uint size, VertexBufferLayout layout);
-        DX11VertexBuffer(void* vertices, Uint size, VertexBufferLayout layout);
+        DX11VertexBuffer(BufferView vertices, VertexBufferLayout layout);
         virtual ~DX11VertexBuffer();
         virtual void Bind() const override;
         virtual void Unbind() const override;
-        virtual void SetData(const void* data, Uint size) override;
+        virtual void SetData(BufferView data) override;
 
         virtual void SetLayout(const VertexBufferLayout& layout) override { mLayout = layout; }
         virtual const VertexBufferLayout& GetLayout() const override { return mLayout; }
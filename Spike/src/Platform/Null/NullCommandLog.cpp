@@ -0,0 +1,78 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "NullCommandLog.h"
+
+namespace Spike
+{
+    static Vector<NullCommand> s_Commands;
+    static NullCommandStats s_Stats;
+    static bool s_Recording = true;
+
+    void NullCommandLog::Record(const NullCommand& command)
+    {
+        switch (command.Type)
+        {
+            case NullCommandType::BindVertexBuffer:
+            case NullCommandType::BindIndexBuffer:
+            case NullCommandType::BindConstantBuffer:
+            case NullCommandType::BindTexture:
+            case NullCommandType::BindShader:
+            case NullCommandType::BindPipeline:
+            case NullCommandType::BindFramebuffer:
+                s_Stats.Binds++; break;
+            case NullCommandType::UploadVertexBuffer:
+            case NullCommandType::UploadConstantBuffer:
+            case NullCommandType::UploadTexture:
+                s_Stats.Uploads++;
+                s_Stats.UploadedBytes += command.Size; break;
+            case NullCommandType::DrawIndexed:
+            case NullCommandType::DrawIndexedMesh:
+                s_Stats.DrawCalls++;
+                s_Stats.IndexCount += command.Size; break;
+            case NullCommandType::DrawIndexedInstanced:
+                s_Stats.DrawCalls++;
+                s_Stats.IndexCount += (uint64_t)command.Size * command.InstanceCount; break;
+            default:
+                break;
+        }
+
+        if (s_Recording)
+            s_Commands.push_back(command);
+    }
+
+    void NullCommandLog::Clear()
+    {
+        s_Commands.clear();
+        s_Stats = NullCommandStats();
+    }
+
+    const Vector<NullCommand>& NullCommandLog::GetCommands()
+    {
+        return s_Commands;
+    }
+
+    const NullCommandStats& NullCommandLog::GetStats()
+    {
+        return s_Stats;
+    }
+
+    Uint NullCommandLog::CountOf(NullCommandType type)
+    {
+        Uint count = 0;
+        for (const NullCommand& command : s_Commands)
+            if (command.Type == type)
+                count++;
+        return count;
+    }
+
+    void NullCommandLog::SetRecording(bool enabled)
+    {
+        s_Recording = enabled;
+    }
+
+    bool NullCommandLog::IsRecording()
+    {
+        return s_Recording;
+    }
+}
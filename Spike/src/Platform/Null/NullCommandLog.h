@@ -0,0 +1,66 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Core/Base.h"
+
+namespace Spike
+{
+    enum class NullCommandType
+    {
+        None = 0,
+        BindVertexBuffer,
+        BindIndexBuffer,
+        BindConstantBuffer,
+        BindTexture,
+        BindShader,
+        BindPipeline,
+        BindFramebuffer,
+        UploadVertexBuffer,
+        UploadConstantBuffer,
+        UploadTexture,
+        DrawIndexed,
+        DrawIndexedMesh,
+        DrawIndexedInstanced,
+        Clear,
+        SetViewport,
+        BeginWireframe,
+        EndWireframe,
+        SetDepthTest
+    };
+
+    struct NullCommand
+    {
+        NullCommandType Type = NullCommandType::None;
+        const void* Object = nullptr; /* [Spike] The resource the command was issued on, nullptr for the backbuffer/global state [Spike] */
+        Uint Slot = 0;                /* [Spike] Bind slot, viewport width or DepthTestFunc [Spike] */
+        Uint Size = 0;                /* [Spike] Bytes for uploads, index count for draws, viewport height [Spike] */
+        Uint BaseIndex = 0;
+        Uint BaseVertex = 0;
+        Uint InstanceCount = 0;
+    };
+
+    struct NullCommandStats
+    {
+        Uint Binds = 0;
+        Uint Uploads = 0;
+        uint64_t UploadedBytes = 0;
+        Uint DrawCalls = 0;
+        uint64_t IndexCount = 0;
+    };
+
+    /* [Spike] Records everything the Null RendererAPI is asked to do, so frame building can be inspected and measured without a GPU [Spike] */
+    class NullCommandLog
+    {
+    public:
+        static void Record(const NullCommand& command);
+        static void Clear();
+
+        static const Vector<NullCommand>& GetCommands();
+        static const NullCommandStats& GetStats();
+        static Uint CountOf(NullCommandType type);
+
+        /* [Spike] When disabled only the stats are updated, useful when timing large frames [Spike] */
+        static void SetRecording(bool enabled);
+        static bool IsRecording();
+    };
+}
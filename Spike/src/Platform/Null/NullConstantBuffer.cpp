@@ -0,0 +1,46 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "NullConstantBuffer.h"
+#include "NullCommandLog.h"
+#include <cstring>
+
+namespace Spike
+{
+    NullConstantBuffer::NullConstantBuffer(const Ref<Shader>& shader, const String& name, void* data, const Uint size, const Uint bindSlot, ShaderDomain shaderDomain, DataUsage usage)
+        :m_Name(name), m_BindSlot(bindSlot), m_Size(size), m_ShaderDomain(shaderDomain), m_DataUsage(usage)
+    {
+        /* [Spike] We keep a CPU copy, so the last uploaded contents can be inspected [Spike] */
+        m_Data = new byte[size];
+        if (data)
+            memcpy(m_Data, data, size);
+        else
+            memset(m_Data, 0, size);
+    }
+
+    NullConstantBuffer::~NullConstantBuffer()
+    {
+        delete[] m_Data;
+    }
+
+    void NullConstantBuffer::Bind()
+    {
+        NullCommand command;
+        command.Type = NullCommandType::BindConstantBuffer;
+        command.Object = this;
+        command.Slot = m_BindSlot;
+        NullCommandLog::Record(command);
+    }
+
+    void NullConstantBuffer::SetData(void* data)
+    {
+        memcpy(m_Data, data, m_Size);
+
+        NullCommand command;
+        command.Type = NullCommandType::UploadConstantBuffer;
+        command.Object = this;
+        command.Slot = m_BindSlot;
+        command.Size = m_Size;
+        NullCommandLog::Record(command);
+    }
+}
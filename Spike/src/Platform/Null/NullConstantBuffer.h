@@ -0,0 +1,30 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Renderer/ConstantBuffer.h"
+
+namespace Spike
+{
+    class NullConstantBuffer : public ConstantBuffer
+    {
+    public:
+        NullConstantBuffer(const Ref<Shader>& shader, const String& name, void* data, const Uint size, const Uint bindSlot, ShaderDomain shaderDomain = ShaderDomain::VERTEX, DataUsage usage = DataUsage::DYNAMIC);
+        virtual ~NullConstantBuffer();
+        virtual void Bind() override;
+        virtual void* GetData() override { return m_Data; }
+        virtual DataUsage GetDataUsage() override { return m_DataUsage; }
+        virtual RendererID GetNativeBuffer() override { return (RendererID)this; }
+        virtual ShaderDomain GetShaderDomain() override { return m_ShaderDomain; }
+        virtual Uint GetSize() override { return m_Size; }
+        virtual void SetData(void* data) override;
+    private:
+        String m_Name;
+        byte* m_Data;
+        Uint m_BindSlot;
+        Uint m_Size;
+        ShaderDomain m_ShaderDomain;
+        DataUsage m_DataUsage;
+    };
+
+    SPK_POOL_ALLOCATE(NullConstantBuffer);
+}
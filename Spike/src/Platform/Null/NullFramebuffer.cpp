@@ -0,0 +1,33 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "NullFramebuffer.h"
+#include "NullCommandLog.h"
+
+namespace Spike
+{
+    NullFramebuffer::NullFramebuffer(const FramebufferSpecification& spec)
+        :m_Specification(spec) {}
+
+    void NullFramebuffer::Bind()
+    {
+        NullCommand command;
+        command.Type = NullCommandType::BindFramebuffer;
+        command.Object = this;
+        NullCommandLog::Record(command);
+    }
+
+    void NullFramebuffer::Resize(Uint width, Uint height)
+    {
+        m_Specification.Width = width;
+        m_Specification.Height = height;
+    }
+
+    void NullFramebuffer::Clear(const glm::vec4& clearColor)
+    {
+        NullCommand command;
+        command.Type = NullCommandType::Clear;
+        command.Object = this;
+        NullCommandLog::Record(command);
+    }
+}
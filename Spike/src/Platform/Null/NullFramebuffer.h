@@ -0,0 +1,24 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Renderer/Framebuffer.h"
+
+namespace Spike
+{
+    class NullFramebuffer : public Framebuffer
+    {
+    public:
+        NullFramebuffer(const FramebufferSpecification& spec);
+        virtual ~NullFramebuffer() = default;
+
+        virtual void Bind() override;
+        virtual void Unbind() override {}
+        virtual void Resize(Uint width, Uint height) override;
+        virtual FramebufferSpecification& GetSpecification() override { return m_Specification; }
+        virtual void Clear(const glm::vec4& clearColor) override;
+        virtual RendererID GetColorViewID() override { return (RendererID)this; }
+        virtual RendererID GetSwapChainTarget() override { return (RendererID)this; }
+    private:
+        FramebufferSpecification m_Specification;
+    };
+}
@@ -0,0 +1,19 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "NullIndexBuffer.h"
+#include "NullCommandLog.h"
+
+namespace Spike
+{
+    NullIndexBuffer::NullIndexBuffer(void* indices, Uint count)
+        :m_Count(count) {}
+
+    void NullIndexBuffer::Bind() const
+    {
+        NullCommand command;
+        command.Type = NullCommandType::BindIndexBuffer;
+        command.Object = this;
+        NullCommandLog::Record(command);
+    }
+}
@@ -0,0 +1,21 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Renderer/IndexBuffer.h"
+
+namespace Spike
+{
+    class NullIndexBuffer : public IndexBuffer
+    {
+    public:
+        NullIndexBuffer(void* indices, Uint count);
+        virtual ~NullIndexBuffer() = default;
+
+        virtual void Bind() const override;
+        virtual void Unbind() const override {}
+
+        virtual Uint GetCount() const override { return m_Count; }
+    private:
+        Uint m_Count;
+    };
+}
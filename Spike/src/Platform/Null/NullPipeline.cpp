@@ -0,0 +1,29 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "NullPipeline.h"
+#include "NullCommandLog.h"
+
+namespace Spike
+{
+    NullPipeline::NullPipeline(const PipelineSpecification& spec)
+        :m_Specification(spec)
+    {
+        SPK_CORE_ASSERT(m_Specification.VertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
+    }
+
+    void NullPipeline::Bind() const
+    {
+        NullCommand command;
+        command.Type = NullCommandType::BindPipeline;
+        command.Object = this;
+        NullCommandLog::Record(command);
+    }
+
+    void NullPipeline::BindSpecificationObjects() const
+    {
+        m_Specification.VertexBuffer->Bind();
+        m_Specification.IndexBuffer->Bind();
+        m_Specification.Shader->Bind();
+    }
+}
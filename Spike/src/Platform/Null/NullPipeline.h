@@ -0,0 +1,23 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Renderer/Pipeline.h"
+
+namespace Spike
+{
+    class NullPipeline : public Pipeline
+    {
+    public:
+        NullPipeline(const PipelineSpecification& spec);
+        virtual ~NullPipeline() = default;
+
+        virtual void Bind() const override;
+        virtual void BindSpecificationObjects() const override;
+        virtual void Unbind() const override {}
+        virtual PipelineSpecification& GetSpecification() override { return m_Specification; }
+        virtual void SetPrimitiveTopology(PrimitiveTopology topology) override { m_PrimitiveTopology = topology; }
+    private:
+        PipelineSpecification m_Specification;
+        PrimitiveTopology m_PrimitiveTopology = PrimitiveTopology::TRIANGLELIST;
+    };
+}
@@ -0,0 +1,98 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "NullRendererAPI.h"
+#include "NullCommandLog.h"
+
+namespace Spike
+{
+    void NullRendererAPI::Init()
+    {
+        auto& caps = RendererAPI::GetCapabilities();
+
+        caps.Vendor = "Spike Technologies";
+        caps.Renderer = "Null Renderer";
+        caps.Version = "None";
+        caps.MaxTextureUnits = 32;
+        caps.MaxSamples = 1;
+    }
+
+    void NullRendererAPI::SetViewport(Uint x, Uint y, Uint width, Uint height)
+    {
+        NullCommand command;
+        command.Type = NullCommandType::SetViewport;
+        command.Slot = width;
+        command.Size = height;
+        NullCommandLog::Record(command);
+    }
+
+    void NullRendererAPI::SetClearColor(const glm::vec4& color)
+    {
+        m_ClearColor = color;
+    }
+
+    void NullRendererAPI::Clear()
+    {
+        NullCommand command;
+        command.Type = NullCommandType::Clear;
+        NullCommandLog::Record(command);
+    }
+
+    void NullRendererAPI::DrawIndexed(Ref<Pipeline>& pipeline, Uint indexCount)
+    {
+        NullCommand command;
+        command.Type = NullCommandType::DrawIndexed;
+        command.Object = pipeline.Raw();
+        command.Size = indexCount ? indexCount : pipeline->GetSpecification().IndexBuffer->GetCount();
+        NullCommandLog::Record(command);
+    }
+
+    void NullRendererAPI::DrawIndexedMesh(Uint indexCount, Uint baseIndex, Uint baseVertex)
+    {
+        NullCommand command;
+        command.Type = NullCommandType::DrawIndexedMesh;
+        command.Size = indexCount;
+        command.BaseIndex = baseIndex;
+        command.BaseVertex = baseVertex;
+        NullCommandLog::Record(command);
+    }
+
+    void NullRendererAPI::DrawIndexedInstanced(Ref<Pipeline>& pipeline, Uint indexCount, Uint instanceCount)
+    {
+        NullCommand command;
+        command.Type = NullCommandType::DrawIndexedInstanced;
+        command.Object = pipeline.Raw();
+        command.Size = indexCount;
+        command.InstanceCount = instanceCount;
+        NullCommandLog::Record(command);
+    }
+
+    void NullRendererAPI::BindBackbuffer()
+    {
+        NullCommand command;
+        command.Type = NullCommandType::BindFramebuffer;
+        NullCommandLog::Record(command);
+    }
+
+    void NullRendererAPI::BeginWireframe()
+    {
+        NullCommand command;
+        command.Type = NullCommandType::BeginWireframe;
+        NullCommandLog::Record(command);
+    }
+
+    void NullRendererAPI::EndWireframe()
+    {
+        NullCommand command;
+        command.Type = NullCommandType::EndWireframe;
+        NullCommandLog::Record(command);
+    }
+
+    void NullRendererAPI::SetDepthTest(DepthTestFunc type)
+    {
+        NullCommand command;
+        command.Type = NullCommandType::SetDepthTest;
+        command.Slot = (Uint)type;
+        NullCommandLog::Record(command);
+    }
+}
@@ -0,0 +1,20 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "NullShader.h"
+#include "NullCommandLog.h"
+#include "Spike/Core/Vault.h"
+
+namespace Spike
+{
+    NullShader::NullShader(const String& filepath)
+        :m_Name(Vault::GetNameWithExtension(filepath)), m_Filepath(filepath) {}
+
+    void NullShader::Bind() const
+    {
+        NullCommand command;
+        command.Type = NullCommandType::BindShader;
+        command.Object = this;
+        NullCommandLog::Record(command);
+    }
+}
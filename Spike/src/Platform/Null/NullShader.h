@@ -0,0 +1,31 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Renderer/Shader.h"
+
+namespace Spike
+{
+    class NullShader : public Shader
+    {
+    public:
+        NullShader(const String& filepath);
+        virtual ~NullShader() = default;
+
+        virtual void Bind() const override;
+        virtual void Unbind() const override {}
+        virtual const String& GetName() const override { return m_Name; }
+        virtual String GetFilepath() const override { return m_Filepath; }
+        virtual RendererID GetRendererID() const override { return (RendererID)this; }
+        virtual void* GetNativeClass() override { return this; }
+
+        virtual void SetInt(const String& name, int value) override {}
+        virtual void SetIntArray(const String& name, int* value, Uint count) override {}
+        virtual void SetFloat(const String& name, float value) override {}
+        virtual void SetFloat2(const String& name, const glm::vec2& value) override {}
+        virtual void SetFloat3(const String& name, const glm::vec3& value) override {}
+        virtual void SetFloat4(const String& name, const glm::vec4& value) override {}
+        virtual void SetMat4(const String& name, const glm::mat4& value) override {}
+    private:
+        String m_Name, m_Filepath;
+    };
+}
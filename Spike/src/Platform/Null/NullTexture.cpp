@@ -0,0 +1,67 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "NullTexture.h"
+#include "NullCommandLog.h"
+#include "Spike/Core/Vault.h"
+#include <stb_image.h>
+
+namespace Spike
+{
+    NullTexture2D::NullTexture2D(Uint width, Uint height)
+        :m_Name("Built-In Texture"), m_Width(width), m_Height(height)
+    {
+        m_Loaded = true;
+    }
+
+    NullTexture2D::NullTexture2D(const String& path, bool flipped)
+        :m_FilePath(path), m_Name(Vault::GetNameWithExtension(path))
+    {
+        Reload(flipped);
+    }
+
+    void NullTexture2D::Reload(bool flip)
+    {
+        /* [Spike] Only the header is read, there is nowhere to upload the pixels to [Spike] */
+        int width, height, channels;
+        m_Loaded = stbi_info(m_FilePath.c_str(), &width, &height, &channels);
+        if (m_Loaded)
+        {
+            m_Width = (Uint)width;
+            m_Height = (Uint)height;
+        }
+        else
+            SPK_CORE_LOG_WARN("Null texture could not read the image header of \"%s\"", m_FilePath.c_str());
+    }
+
+    void NullTexture2D::SetData(BufferView data)
+    {
+        SPK_CORE_ASSERT(data.Size == m_Width * m_Height * 4, "Data must be entire texture!");
+        NullCommand command;
+        command.Type = NullCommandType::UploadTexture;
+        command.Object = this;
+        command.Size = (Uint)data.Size;
+        NullCommandLog::Record(command);
+    }
+
+    void NullTexture2D::Bind(Uint slot, ShaderDomain domain) const
+    {
+        NullCommand command;
+        command.Type = NullCommandType::BindTexture;
+        command.Object = this;
+        command.Slot = slot;
+        NullCommandLog::Record(command);
+    }
+
+    NullTextureCube::NullTextureCube(const String& folderPath)
+        :m_FilePath(folderPath), m_Name(Vault::GetNameWithoutExtension(folderPath)) {}
+
+    void NullTextureCube::Bind(Uint slot, ShaderDomain domain) const
+    {
+        NullCommand command;
+        command.Type = NullCommandType::BindTexture;
+        command.Object = this;
+        command.Slot = slot;
+        NullCommandLog::Record(command);
+    }
+}
@@ -0,0 +1,56 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Renderer/Texture.h"
+
+namespace Spike
+{
+    class NullTexture2D : public Texture2D
+    {
+    public:
+        NullTexture2D(Uint width, Uint height);
+        NullTexture2D(const String& path, bool flipped = false);
+        virtual ~NullTexture2D() = default;
+        virtual String const GetName() const override { return m_Name; }
+        virtual Uint GetWidth() const override { return m_Width; }
+        virtual Uint GetHeight() const override { return m_Height; }
+        virtual RendererID GetRendererID() const override { return (RendererID)this; }
+        virtual String GetFilepath() const override { return m_FilePath; }
+        virtual void SetData(BufferView data) override;
+        virtual void Bind(Uint slot = 0, ShaderDomain domain = ShaderDomain::PIXEL) const override;
+        virtual void Unbind() const override {}
+        virtual bool Loaded() override { return m_Loaded; }
+        virtual void Reload(bool flip = false) override;
+        virtual bool operator==(const Texture& other) const override { return this == &other; }
+    private:
+        bool m_Loaded = false;
+        String m_FilePath;
+        String m_Name;
+        Uint m_Width = 0, m_Height = 0;
+    };
+
+    class NullTextureCube : public TextureCube
+    {
+    public:
+        NullTextureCube(const String& folderPath);
+        virtual ~NullTextureCube() = default;
+        virtual void Bind(Uint slot = 0, ShaderDomain domain = ShaderDomain::PIXEL) const override;
+        virtual String GetFilepath() const override { return m_FilePath; }
+        virtual Uint GetWidth() const override { return m_Width; }
+        virtual Uint GetHeight() const override { return m_Height; }
+        virtual String const GetName() const override { return m_Name; }
+        virtual RendererID GetRendererID() const override { return (RendererID)this; }
+        virtual bool Loaded() override { return m_Loaded; }
+        virtual void Reload(bool flip = false) override {}
+        virtual void SetData(BufferView data) override {}
+        virtual void Unbind() const override {}
+        virtual bool operator==(const Texture& other) const override { return this == &other; }
+    private:
+        String m_FilePath;
+        String m_Name;
+        Uint m_Width = 0, m_Height = 0;
+        bool m_Loaded = true;
+    };
+
+    SPK_POOL_ALLOCATE(NullTexture2D);
+}
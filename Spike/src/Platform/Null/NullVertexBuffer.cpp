@@ -0,0 +1,39 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "NullVertexBuffer.h"
+#include "NullCommandLog.h"
+
+namespace Spike
+{
+    NullVertexBuffer::NullVertexBuffer(Uint size, VertexBufferLayout layout)
+        :m_Size(size), m_Layout(layout) {}
+
+    NullVertexBuffer::NullVertexBuffer(BufferView vertices, VertexBufferLayout layout)
+        :m_Size((Uint)vertices.Size), m_Layout(layout)
+    {
+        NullCommand command;
+        command.Type = NullCommandType::UploadVertexBuffer;
+        command.Object = this;
+        command.Size = m_Size;
+        NullCommandLog::Record(command);
+    }
+
+    void NullVertexBuffer::Bind() const
+    {
+        NullCommand command;
+        command.Type = NullCommandType::BindVertexBuffer;
+        command.Object = this;
+        NullCommandLog::Record(command);
+    }
+
+    void NullVertexBuffer::SetData(BufferView data)
+    {
+        SPK_CORE_ASSERT(data.Size <= m_Size, "VertexBuffer overflow!");
+        NullCommand command;
+        command.Type = NullCommandType::UploadVertexBuffer;
+        command.Object = this;
+        command.Size = (Uint)data.Size;
+        NullCommandLog::Record(command);
+    }
+}
@@ -0,0 +1,27 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Renderer/VertexBuffer.h"
+
+namespace Spike
+{
+    class NullVertexBuffer : public VertexBuffer
+    {
+    public:
+        NullVertexBuffer(Uint size, VertexBufferLayout layout);
+        NullVertexBuffer(BufferView vertices, VertexBufferLayout layout);
+        virtual ~NullVertexBuffer() = default;
+
+        virtual void Bind() const override;
+        virtual void Unbind() const override {}
+
+        virtual void SetData(BufferView data) override;
+
+        virtual const VertexBufferLayout& GetLayout() const override { return m_Layout; }
+        virtual void SetLayout(const VertexBufferLayout& layout) override { m_Layout = layout; }
+        Uint GetSize() const { return m_Size; }
+    private:
+        Uint m_Size;
+        VertexBufferLayout m_Layout;
+    };
+}
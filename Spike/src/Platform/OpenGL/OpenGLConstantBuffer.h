@@ -26,4 +26,6 @@ namespace Spike
         DataUsage m_DataUsage;
         RendererID m_RendererID;
     };
+
+    SPK_POOL_ALLOCATE(OpenGLConstantBuffer);
 }
@@ -38,6 +38,7 @@ namespace Spike
         m_Specification.VertexBuffer->Bind();
 
         const auto& layout = m_Specification.VertexBuffer->GetLayout();
+        const Uint firstAttribute = m_VertexBufferIndex;
         for (const auto& element : layout)
         {
             switch (element.Type)
@@ -94,6 +95,12 @@ namespace Spike
                 SPK_INTERNAL_ASSERT("Unknown ShaderDataType!");
             }
         }
+        if (layout.GetInputRate() == VertexInputRate::PerInstance)
+        {
+            for (Uint i = firstAttribute; i < m_VertexBufferIndex; i++)
+                glVertexAttribDivisor(i, 1);
+        }
+
         glBindVertexArray(rendererID);
         m_Specification.IndexBuffer->Bind();
         m_RendererID = (RendererID)rendererID;
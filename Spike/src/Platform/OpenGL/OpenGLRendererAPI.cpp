@@ -79,6 +79,11 @@ namespace Spike
         glDrawElementsBaseVertex(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, (void*)(sizeof(Uint) * baseIndex), baseVertex);
     }
 
+    void OpenGLRendererAPI::DrawIndexedInstanced(Ref<Pipeline>& pipeline, Uint indexCount, Uint instanceCount)
+    {
+        glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, instanceCount);
+    }
+
     void OpenGLRendererAPI::BindBackbuffer() {}
 
     void OpenGLRendererAPI::BeginWireframe()
@@ -14,6 +14,7 @@ namespace Spike
         virtual void Clear() override;
         virtual void DrawIndexed(Ref<Pipeline>& pipeline, Uint indexCount = 0) override;
         virtual void DrawIndexedMesh(Uint indexCount, Uint baseIndex, Uint baseVertex) override;
+        virtual void DrawIndexedInstanced(Ref<Pipeline>& pipeline, Uint indexCount, Uint instanceCount) override;
         virtual void BindBackbuffer() override;
         virtual void BeginWireframe() override;
         virtual void EndWireframe() override;
@@ -3,6 +3,7 @@
 #include "spkpch.h"
 #include "OpenGLShader.h"
 #include "Spike/Core/Vault.h"
+#include "Spike/Core/Profiler.h"
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 
@@ -20,8 +21,8 @@ namespace Spike
     OpenGLShader::OpenGLShader(const String& filepath)
         :m_Filepath(filepath), m_Name(Vault::GetNameWithExtension(filepath))
     {
-        String source = Vault::ReadFile(m_Filepath);
-        m_ShaderSource = PreProcess(source);
+        MappedFile source = Vault::MapFile(m_Filepath);
+        m_ShaderSource = PreProcess(source.GetString());
         Compile();
     }
 
@@ -38,26 +39,26 @@ namespace Spike
         glDeleteProgram(rendererID);
     }
 
-    std::unordered_map<GLenum, String> OpenGLShader::PreProcess(const String& source)
+    std::unordered_map<GLenum, String> OpenGLShader::PreProcess(std::string_view source)
     {
         std::unordered_map<GLenum, String> shaderSources;
 
         const char* typeToken = "#type";
         size_t typeTokenLength = strlen(typeToken);
         size_t pos = source.find(typeToken, 0); //Start of shader type declaration line
-        while (pos != String::npos)
+        while (pos != std::string_view::npos)
         {
             size_t eol = source.find_first_of("\r\n", pos); //End of shader type declaration line
-            SPK_CORE_ASSERT(eol != String::npos, "Syntax error");
+            SPK_CORE_ASSERT(eol != std::string_view::npos, "Syntax error");
             size_t begin = pos + typeTokenLength + 1; //Start of shader type name (after "#type " keyword)
-            String type = source.substr(begin, eol - begin);
+            String type = String(source.substr(begin, eol - begin));
             SPK_CORE_ASSERT(ShaderTypeFromString(type), "Invalid shader type specified");
 
             size_t nextLinePos = source.find_first_not_of("\r\n", eol); //Start of shader code after shader type declaration line
-            SPK_CORE_ASSERT(nextLinePos != String::npos, "Syntax error");
+            SPK_CORE_ASSERT(nextLinePos != std::string_view::npos, "Syntax error");
             pos = source.find(typeToken, nextLinePos); //Start of next shader type declaration line
 
-            shaderSources[ShaderTypeFromString(type)] = (pos == String::npos) ? source.substr(nextLinePos) : source.substr(nextLinePos, pos - nextLinePos);
+            shaderSources[ShaderTypeFromString(type)] = String((pos == std::string_view::npos) ? source.substr(nextLinePos) : source.substr(nextLinePos, pos - nextLinePos));
         }
 
         return shaderSources;
@@ -65,6 +66,7 @@ namespace Spike
 
     void OpenGLShader::Compile()
     {
+        SPK_PROFILE_FUNCTION();
         GLuint program = glCreateProgram();
         SPK_CORE_ASSERT(m_ShaderSource.size() <= 2, "We only support two shaders for now.");
         std::array<GLenum, 2> glShaderIDs;
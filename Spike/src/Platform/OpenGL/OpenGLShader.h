@@ -3,6 +3,7 @@
 #pragma once
 #include <Spike/Renderer/Shader.h>
 #include <glm/glm.hpp>
+#include <string_view>
 
 typedef unsigned int GLenum;
 namespace Spike
@@ -29,7 +30,7 @@ namespace Spike
         virtual void SetFloat4(const String& name, const glm::vec4& value) override;
         virtual void SetMat4(const String& name, const glm::mat4& value) override;
     private:
-        std::unordered_map<GLenum, String> PreProcess(const String& source);
+        std::unordered_map<GLenum, String> PreProcess(std::string_view source);
         void Compile();
 
         void UploadUniformInt(const String& name, int value);
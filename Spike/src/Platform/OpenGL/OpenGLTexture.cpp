@@ -3,6 +3,7 @@
 #include "spkpch.h"
 #include "OpenGLTexture.h"
 #include "Spike/Core/Vault.h"
+#include "Spike/Core/Profiler.h"
 #include <filesystem>
 #include <stb_image.h>
 
@@ -53,6 +54,7 @@ namespace Spike
 
     void OpenGLTexture2D::Reload(bool flip)
     {
+        SPK_PROFILE_FUNCTION();
         if (m_RendererID)
         {
             Uint rendererID = reinterpret_cast<Uint>(m_RendererID);
@@ -116,12 +118,12 @@ namespace Spike
         free(data);
     }
 
-    void OpenGLTexture2D::SetData(void* data, Uint size)
+    void OpenGLTexture2D::SetData(BufferView data)
     {
         Uint bpp = m_DataFormat == GL_RGBA ? 4 : 3;
-        SPK_CORE_ASSERT(size == m_Width * m_Height * bpp, "Data must be entire texture!");
+        SPK_CORE_ASSERT(data.Size == m_Width * m_Height * bpp, "Data must be entire texture!");
         glBindTexture(GL_TEXTURE_2D, (GLuint)m_RendererID);
-        glTexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, m_Width, m_Height, 0, m_DataFormat, GL_UNSIGNED_BYTE, data);
+        glTexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, m_Width, m_Height, 0, m_DataFormat, GL_UNSIGNED_BYTE, data.Data);
     }
 
     /*
@@ -140,7 +142,7 @@ namespace Spike
         std::sort(m_Faces.begin(), m_Faces.end());
 
         for (uint8_t i = 0; i < 6; i++)
-            SPK_CORE_LOG_INFO(m_Faces[i].c_str());
+            SPK_CORE_LOG_INFO("%s", m_Faces[i].c_str());
 
         LoadTextureCube(false);
     }
@@ -18,7 +18,7 @@ namespace Spike
         virtual Uint GetHeight() const override { return m_Height; }
         virtual RendererID GetRendererID() const override { return (RendererID)m_RendererID; };
         virtual String GetFilepath() const override { return m_FilePath; }
-        void SetData(void* data, Uint size) override;
+        void SetData(BufferView data) override;
         virtual void Bind(Uint slot = 0, ShaderDomain domain = ShaderDomain::PIXEL) const override;
         virtual void Unbind() const override;
         virtual bool Loaded() override { return m_Loaded; }
@@ -48,7 +48,7 @@ namespace Spike
         virtual RendererID GetRendererID() const override { return m_RendererID; }
         virtual bool Loaded() override { return m_Loaded; }
         virtual void Reload(bool flip = false) override;
-        virtual void SetData(void* data, Uint size) override {}
+        virtual void SetData(BufferView data) override {}
         virtual void Unbind() const override;
         virtual bool operator ==(const Texture& other) const override { return m_RendererID == ((OpenGLTextureCube&)other).m_RendererID; }
     private:
@@ -62,4 +62,6 @@ namespace Spike
         String m_Name;
         bool m_Loaded = false;
     };
+
+    SPK_POOL_ALLOCATE(OpenGLTexture2D);
 }
\ No newline at end of file
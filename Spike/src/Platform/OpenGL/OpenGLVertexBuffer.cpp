@@ -17,13 +17,13 @@ namespace Spike
         m_RendererID = (RendererID)rendererID;
     }
 
-    OpenGLVertexBuffer::OpenGLVertexBuffer(void* vertices, Uint size, VertexBufferLayout layout)
+    OpenGLVertexBuffer::OpenGLVertexBuffer(BufferView vertices, VertexBufferLayout layout)
         :m_Layout(layout)
     {
         Uint rendererID;
         glGenBuffers(1, &rendererID);
         glBindBuffer(GL_ARRAY_BUFFER, rendererID);
-        glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)vertices.Size, vertices.Data, GL_STATIC_DRAW);
         m_RendererID = (RendererID)rendererID;
     }
 
@@ -43,9 +43,9 @@ namespace Spike
         glBindBuffer(GL_ARRAY_BUFFER, 0);
     }
 
-    void OpenGLVertexBuffer::SetData(const void* data, Uint size)
+    void OpenGLVertexBuffer::SetData(BufferView data)
     {
         glBindBuffer(GL_ARRAY_BUFFER, (GLuint)m_RendererID);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)data.Size, data.Data);
     }
 }
\ No newline at end of file
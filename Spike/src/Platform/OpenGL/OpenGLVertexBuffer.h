@@ -9,13 +9,13 @@ namespace Spike
     {
     public:
         OpenGLVertexBuffer(Uint size, VertexBufferLayout layout);
-        OpenGLVertexBuffer(void* vertices, Uint size, VertexBufferLayout layout);
+        OpenGLVertexBuffer(BufferView vertices, VertexBufferLayout layout);
         virtual ~OpenGLVertexBuffer();
 
         virtual void Bind() const override;
         virtual void Unbind() const override;
 
-        virtual void SetData(const void* data, Uint size) override;
+        virtual void SetData(BufferView data) override;
 
         virtual const VertexBufferLayout& GetLayout() const override { return m_Layout; }
         virtual void SetLayout(const VertexBufferLayout& layout) override { m_Layout = layout; }
@@ -8,6 +8,11 @@
 #include "Spike/Renderer/Renderer2D.h"
 #include "Spike/Core/Input.h"
 #include "Spike/Core/Vault.h"
+#include "Spike/Core/JobSystem.h"
+#include "Spike/Core/FrameAllocator.h"
+#include "Spike/Core/MemoryTracker.h"
+#include "Spike/Core/Profiler.h"
+#include "Spike/Core/FrameStats.h"
 #include "Spike/Utility/FileDialogs.h"
 #include "Spike/Scripting/ScriptEngine.h"
 #include <GLFW/glfw3.h>
@@ -24,6 +29,9 @@ namespace Spike
         SPK_CORE_ASSERT(!s_Instance, "Application already exists!");
         s_Instance = this;
 
+        Profiler::SetThreadName("Main");
+        FrameAllocator::Init();
+        JobSystem::Init();
         m_Window = Scope<Window>(Window::Create(WindowProps(name)));
         m_Window->SetEventCallback(BIND_EVENT_FN(OnEvent));
 
@@ -42,6 +50,8 @@ namespace Spike
         Renderer2D::Shutdown();
         ScriptEngine::Shutdown();
         Vault::Shutdown();
+        JobSystem::Shutdown();
+        FrameAllocator::Shutdown();
     }
 
     void Application::PushLayer(Layer* layer)
@@ -137,22 +147,47 @@ namespace Spike
             Timestep timestep = time - m_LastFrameTime;
             m_LastFrameTime = time;
 
-            if(!m_Minimized)
             {
+                SPK_PROFILE_SCOPE("Frame");
                 {
-                    for (Layer* layer : m_LayerStack)
-                        layer->OnUpdate(timestep);
+                    // Work that other threads queued for the graphics context or Mono
+                    SPK_PROFILE_SCOPE("JobSystem::PumpMainThreadJobs");
+                    FrameSystemTimer timer("Main Thread Jobs");
+                    JobSystem::PumpMainThreadJobs();
                 }
 
-                m_ImGuiLayer->Begin();
+                if(!m_Minimized)
                 {
-                    for (Layer* layer : m_LayerStack)
-                        layer->OnImGuiRender();
+                    {
+                        SPK_PROFILE_SCOPE("LayerStack::OnUpdate");
+                        FrameSystemTimer timer("Layer Update");
+                        for (Layer* layer : m_LayerStack)
+                            layer->OnUpdate(timestep);
+                    }
+
+                    FrameSystemTimer timer("ImGui");
+                    m_ImGuiLayer->Begin();
+                    {
+                        SPK_PROFILE_SCOPE("LayerStack::OnImGuiRender");
+                        for (Layer* layer : m_LayerStack)
+                            layer->OnImGuiRender();
+                    }
+                    {
+                        SPK_PROFILE_SCOPE("ImGuiLayer::End");
+                        m_ImGuiLayer->End();
+                    }
                 }
-                m_ImGuiLayer->End();
+
+                SPK_PROFILE_SCOPE("Window::OnUpdate");
+                FrameSystemTimer timer("Present");
+                m_Window->OnUpdate();
             }
 
-            m_Window->OnUpdate();
+            // Nothing is running on the workers between frames, so the oldest frame buffer can be recycled
+            FrameAllocator::EndFrame();
+            MemoryTracker::EndFrame();
+            Profiler::EndFrame();
+            FrameStats::EndFrame();
         }
     }
 
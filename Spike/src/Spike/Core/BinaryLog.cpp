@@ -0,0 +1,542 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "BinaryLog.h"
+#include <cstring>
+#include <cwchar>
+
+namespace Spike
+{
+    enum class ArgumentType
+    {
+        None,     // %% and conversions we don't know, nothing is consumed
+        Signed,   // Stored as int64_t
+        Unsigned, // Stored as uint64_t
+        Char,     // Stored as int64_t
+        Double,   // Stored as double, long doubles lose their extra precision
+        String,   // Stored as a Uint length and the bytes, without the terminator
+        WideString,
+        Pointer,  // Stored as uint64_t
+        Count     // %n, the pointer is skipped and nothing is stored
+    };
+
+    enum class LengthModifier { None, hh, h, l, ll, L, j, z, t };
+
+    struct FormatSpec
+    {
+        const char* Begin = nullptr;       // The %
+        const char* LengthBegin = nullptr; // Where the length modifier (or the conversion) starts
+        const char* End = nullptr;         // One past the conversion
+        char Conversion = 0;
+        LengthModifier Length = LengthModifier::None;
+        ArgumentType Type = ArgumentType::None;
+        int StarCount = 0;                 // Width and precision given as arguments, in the order they are consumed
+        bool PrecisionIsStar = false;
+        int Precision = -1;                // Only when it is written into the format
+    };
+
+    static ArgumentType GetArgumentType(char conversion, LengthModifier length)
+    {
+        switch (conversion)
+        {
+            case 'd': case 'i':
+                return ArgumentType::Signed;
+            case 'u': case 'o': case 'x': case 'X':
+                return ArgumentType::Unsigned;
+            case 'c':
+                return ArgumentType::Char;
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+                return ArgumentType::Double;
+            case 's':
+                return length == LengthModifier::l ? ArgumentType::WideString : ArgumentType::String;
+            case 'p':
+                return ArgumentType::Pointer;
+            case 'n':
+                return ArgumentType::Count;
+        }
+        return ArgumentType::None;
+    }
+
+    /* [Spike] Finds the next conversion at or after cursor. Returns false once the format is done. A conversion we can't
+     * parse ends the format, EncodeArguments and FormatArguments both stop there, so they never disagree [Spike] */
+    static bool NextSpec(const char* cursor, FormatSpec& spec)
+    {
+        const char* c = strchr(cursor, '%');
+        if (!c)
+            return false;
+
+        spec = FormatSpec();
+        spec.Begin = c++;
+        if (*c == '%')
+        {
+            spec.Conversion = '%';
+            spec.LengthBegin = c;
+            spec.End = c + 1;
+            return true;
+        }
+
+        while (*c && strchr("-+ #0", *c))
+            c++;
+        if (*c == '*')
+        {
+            spec.StarCount++;
+            c++;
+        }
+        while (*c >= '0' && *c <= '9')
+            c++;
+        if (*c == '.')
+        {
+            c++;
+            if (*c == '*')
+            {
+                spec.StarCount++;
+                spec.PrecisionIsStar = true;
+                c++;
+            }
+            else
+            {
+                spec.Precision = 0;
+                while (*c >= '0' && *c <= '9')
+                    spec.Precision = spec.Precision * 10 + (*c++ - '0');
+            }
+        }
+
+        spec.LengthBegin = c;
+        switch (*c)
+        {
+            case 'h': spec.Length = c[1] == 'h' ? LengthModifier::hh : LengthModifier::h; c += c[1] == 'h' ? 2 : 1; break;
+            case 'l': spec.Length = c[1] == 'l' ? LengthModifier::ll : LengthModifier::l; c += c[1] == 'l' ? 2 : 1; break;
+            case 'L': spec.Length = LengthModifier::L; c++; break;
+            case 'j': spec.Length = LengthModifier::j; c++; break;
+            case 'z': spec.Length = LengthModifier::z; c++; break;
+            case 't': spec.Length = LengthModifier::t; c++; break;
+        }
+
+        spec.Conversion = *c;
+        spec.Type = GetArgumentType(*c, spec.Length);
+        if (spec.Type == ArgumentType::None)
+            return false;
+        spec.End = c + 1;
+        return true;
+    }
+
+    struct ArgumentWriter
+    {
+        byte* Buffer;
+        Uint Capacity;
+        Uint Size = 0;
+
+        void Write(const void* data, Uint size)
+        {
+            if (Size + size <= Capacity)
+                memcpy(Buffer + Size, data, size);
+            Size += size;
+        }
+
+        template<typename T>
+        void Write(T value) { Write(&value, sizeof(T)); }
+    };
+
+    static int64_t ReadSigned(va_list& args, LengthModifier length)
+    {
+        switch (length)
+        {
+            case LengthModifier::hh: return (signed char)va_arg(args, int);
+            case LengthModifier::h:  return (short)va_arg(args, int);
+            case LengthModifier::l:  return va_arg(args, long);
+            case LengthModifier::ll: return va_arg(args, long long);
+            case LengthModifier::j:  return va_arg(args, intmax_t);
+            case LengthModifier::z:  return (int64_t)va_arg(args, size_t);
+            case LengthModifier::t:  return va_arg(args, ptrdiff_t);
+            default:                 return va_arg(args, int);
+        }
+    }
+
+    static uint64_t ReadUnsigned(va_list& args, LengthModifier length)
+    {
+        switch (length)
+        {
+            case LengthModifier::hh: return (unsigned char)va_arg(args, unsigned int);
+            case LengthModifier::h:  return (unsigned short)va_arg(args, unsigned int);
+            case LengthModifier::l:  return va_arg(args, unsigned long);
+            case LengthModifier::ll: return va_arg(args, unsigned long long);
+            case LengthModifier::j:  return va_arg(args, uintmax_t);
+            case LengthModifier::z:  return va_arg(args, size_t);
+            case LengthModifier::t:  return (uint64_t)va_arg(args, ptrdiff_t);
+            default:                 return va_arg(args, unsigned int);
+        }
+    }
+
+    /* [Spike] What EncodeArguments needs to know about a conversion, parsing the format is most of its cost, so the
+     * conversions of recently used formats are kept per thread [Spike] */
+    struct CompiledSpec
+    {
+        ArgumentType Type;
+        LengthModifier Length;
+        int StarCount;
+        bool PrecisionIsStar;
+        int Precision;
+    };
+
+    struct CompiledFormat
+    {
+        static constexpr Uint MaxSpecs = 8;
+
+        const char* Format = nullptr;
+        Uint Count = 0;
+        CompiledSpec Specs[MaxSpecs];
+    };
+
+    static constexpr Uint FormatCacheSize = 32;
+    static thread_local CompiledFormat s_FormatCache[FormatCacheSize];
+
+    static CompiledSpec Compile(const FormatSpec& spec)
+    {
+        return { spec.Type, spec.Length, spec.StarCount, spec.PrecisionIsStar, spec.Precision };
+    }
+
+    static void EncodeArgument(ArgumentWriter& writer, va_list& arguments, const CompiledSpec& spec)
+    {
+        int stars[2] = {};
+        for (int i = 0; i < spec.StarCount; i++)
+        {
+            stars[i] = va_arg(arguments, int);
+            writer.Write<int32_t>(stars[i]);
+        }
+        // A negative precision argument counts as no precision at all
+        const int precision = spec.PrecisionIsStar ? stars[spec.StarCount - 1] : spec.Precision;
+
+        switch (spec.Type)
+        {
+            case ArgumentType::None:
+                break;
+            case ArgumentType::Signed:
+                writer.Write<int64_t>(ReadSigned(arguments, spec.Length));
+                break;
+            case ArgumentType::Unsigned:
+                writer.Write<uint64_t>(ReadUnsigned(arguments, spec.Length));
+                break;
+            case ArgumentType::Char:
+                writer.Write<int64_t>(spec.Length == LengthModifier::l ? (int64_t)va_arg(arguments, wint_t) : va_arg(arguments, int));
+                break;
+            case ArgumentType::Double:
+                writer.Write<double>(spec.Length == LengthModifier::L ? (double)va_arg(arguments, long double) : va_arg(arguments, double));
+                break;
+            case ArgumentType::String:
+            {
+                const char* string = va_arg(arguments, const char*);
+                if (!string)
+                    string = "(null)";
+                // With a precision the string doesn't have to be terminated
+                const Uint length = (Uint)(precision >= 0 ? strnlen(string, (size_t)precision) : strlen(string));
+                writer.Write<Uint>(length);
+                writer.Write(string, length);
+                break;
+            }
+            case ArgumentType::WideString:
+            {
+                const wchar_t* string = va_arg(arguments, const wchar_t*);
+                if (!string)
+                    string = L"(null)";
+                const Uint length = (Uint)(precision >= 0 ? wcsnlen(string, (size_t)precision) : wcslen(string));
+                writer.Write<Uint>(length);
+                for (Uint i = 0; i < length; i++)
+                    writer.Write<char>((uint32_t)string[i] < 0x80 ? (char)string[i] : '?');
+                break;
+            }
+            case ArgumentType::Pointer:
+                writer.Write<uint64_t>((uint64_t)(uintptr_t)va_arg(arguments, void*));
+                break;
+            case ArgumentType::Count:
+                va_arg(arguments, void*);
+                break;
+        }
+    }
+
+    Uint BinaryLog::EncodeArguments(const char* format, va_list args, byte* buffer, Uint capacity)
+    {
+        // A va_list parameter may have decayed to a pointer, a local copy is what can be passed on by reference
+        va_list arguments;
+        va_copy(arguments, args);
+        ArgumentWriter writer = { buffer, capacity };
+
+        // Formats are string literals, so the pointer is as good as the text
+        CompiledFormat& cached = s_FormatCache[((uintptr_t)format >> 3) % FormatCacheSize];
+        if (cached.Format != format)
+        {
+            cached.Format = nullptr;
+            cached.Count = 0;
+            FormatSpec spec;
+            bool fits = true;
+            for (const char* cursor = format; NextSpec(cursor, spec); cursor = spec.End)
+            {
+                if (spec.Type == ArgumentType::None)
+                    continue;
+                if (cached.Count == CompiledFormat::MaxSpecs)
+                {
+                    fits = false;
+                    break;
+                }
+                cached.Specs[cached.Count++] = Compile(spec);
+            }
+            if (fits)
+                cached.Format = format;
+        }
+
+        if (cached.Format == format)
+        {
+            for (Uint i = 0; i < cached.Count; i++)
+                EncodeArgument(writer, arguments, cached.Specs[i]);
+        }
+        else
+        {
+            // Too many conversions to cache
+            FormatSpec spec;
+            for (const char* cursor = format; NextSpec(cursor, spec); cursor = spec.End)
+                EncodeArgument(writer, arguments, Compile(spec));
+        }
+        va_end(arguments);
+        return writer.Size;
+    }
+
+    struct ArgumentReader
+    {
+        const byte* Data;
+        uint64_t Size;
+        uint64_t Offset = 0;
+
+        bool Read(void* data, uint64_t size)
+        {
+            if (Offset + size > Size)
+                return false;
+            memcpy(data, Data + Offset, (size_t)size);
+            Offset += size;
+            return true;
+        }
+
+        template<typename T>
+        bool Read(T& value) { return Read(&value, sizeof(T)); }
+    };
+
+    template<typename... Args>
+    static void AppendFormatted(String& out, const char* spec, Args... args)
+    {
+        char small[128];
+        const int length = snprintf(small, sizeof(small), spec, args...);
+        if (length < 0)
+            return;
+        if (length < (int)sizeof(small))
+        {
+            out.append(small, (size_t)length);
+            return;
+        }
+
+        const size_t offset = out.size();
+        out.resize(offset + (size_t)length + 1);
+        snprintf(&out[offset], (size_t)length + 1, spec, args...);
+        out.resize(offset + (size_t)length);
+    }
+
+    template<typename T>
+    static void AppendValue(String& out, const char* spec, const int32_t* stars, int starCount, T value)
+    {
+        switch (starCount)
+        {
+            case 0: AppendFormatted(out, spec, value); break;
+            case 1: AppendFormatted(out, spec, stars[0], value); break;
+            case 2: AppendFormatted(out, spec, stars[0], stars[1], value); break;
+        }
+    }
+
+    void BinaryLog::FormatArguments(const char* format, BufferView arguments, String& out)
+    {
+        ArgumentReader reader = { arguments.Data, arguments.Size };
+        FormatSpec spec;
+        const char* cursor = format;
+        for (; NextSpec(cursor, spec); cursor = spec.End)
+        {
+            out.append(cursor, (size_t)(spec.Begin - cursor));
+            if (spec.Conversion == '%')
+            {
+                out.push_back('%');
+                continue;
+            }
+
+            int32_t stars[2] = {};
+            bool complete = true;
+            for (int i = 0; i < spec.StarCount; i++)
+                complete &= reader.Read(stars[i]);
+
+            // Flags, width and precision stay as written, the length modifier becomes the one of the stored type
+            char specText[64] = "%";
+            const size_t prefixLength = std::min<size_t>((size_t)(spec.LengthBegin - spec.Begin) - 1, sizeof(specText) - 8);
+            memcpy(specText + 1, spec.Begin + 1, prefixLength);
+            char* suffix = specText + 1 + prefixLength;
+
+            switch (spec.Type)
+            {
+                case ArgumentType::Signed:
+                case ArgumentType::Unsigned:
+                {
+                    int64_t value = 0;
+                    complete &= reader.Read(value);
+                    suffix[0] = 'l'; suffix[1] = 'l'; suffix[2] = spec.Conversion; suffix[3] = '\0';
+                    if (complete && spec.Type == ArgumentType::Signed)
+                        AppendValue(out, specText, stars, spec.StarCount, (long long)value);
+                    else if (complete)
+                        AppendValue(out, specText, stars, spec.StarCount, (unsigned long long)value);
+                    break;
+                }
+                case ArgumentType::Char:
+                {
+                    int64_t value = 0;
+                    complete &= reader.Read(value);
+                    suffix[0] = 'c'; suffix[1] = '\0';
+                    if (complete)
+                        AppendValue(out, specText, stars, spec.StarCount, (int)(value < 0x100 ? value : '?'));
+                    break;
+                }
+                case ArgumentType::Double:
+                {
+                    double value = 0.0;
+                    complete &= reader.Read(value);
+                    suffix[0] = spec.Conversion; suffix[1] = '\0';
+                    if (complete)
+                        AppendValue(out, specText, stars, spec.StarCount, value);
+                    break;
+                }
+                case ArgumentType::String:
+                case ArgumentType::WideString:
+                {
+                    Uint length = 0;
+                    complete &= reader.Read(length) && reader.Offset + length <= reader.Size;
+                    suffix[0] = 's'; suffix[1] = '\0';
+                    if (complete)
+                    {
+                        const String value((const char*)reader.Data + reader.Offset, length);
+                        reader.Offset += length;
+                        AppendValue(out, specText, stars, spec.StarCount, value.c_str());
+                    }
+                    break;
+                }
+                case ArgumentType::Pointer:
+                {
+                    uint64_t value = 0;
+                    complete &= reader.Read(value);
+                    suffix[0] = 'p'; suffix[1] = '\0';
+                    if (complete)
+                        AppendValue(out, specText, stars, spec.StarCount, (void*)(uintptr_t)value);
+                    break;
+                }
+                case ArgumentType::None:
+                case ArgumentType::Count:
+                    break;
+            }
+
+            if (!complete)
+            {
+                out.append("<missing arguments>");
+                return;
+            }
+        }
+        out.append(cursor);
+    }
+
+    static void WriteChunk(FILE* file, const void* data, size_t size)
+    {
+        fwrite(data, 1, size, file);
+    }
+
+    void BinaryLog::WriteHeader(FILE* file)
+    {
+        WriteChunk(file, Magic, sizeof(Magic));
+        WriteChunk(file, &Version, sizeof(Version));
+    }
+
+    void BinaryLog::WriteString(FILE* file, const char* string)
+    {
+        const char tag = 'S';
+        const uint64_t id = (uint64_t)(uintptr_t)string;
+        const Uint length = (Uint)strlen(string);
+        WriteChunk(file, &tag, sizeof(tag));
+        WriteChunk(file, &id, sizeof(id));
+        WriteChunk(file, &length, sizeof(length));
+        WriteChunk(file, string, length);
+    }
+
+    void BinaryLog::WriteMessage(FILE* file, const BinaryLogMessage& message)
+    {
+        const char tag = 'M';
+        const uint8_t level = (uint8_t)message.Level;
+        const uint64_t formatID = (uint64_t)(uintptr_t)message.Format;
+        const uint64_t nameID = (uint64_t)(uintptr_t)message.Name;
+        const Uint argumentsSize = (Uint)message.Arguments.Size;
+        WriteChunk(file, &tag, sizeof(tag));
+        WriteChunk(file, &level, sizeof(level));
+        WriteChunk(file, &message.ThreadID, sizeof(message.ThreadID));
+        WriteChunk(file, &message.Timestamp, sizeof(message.Timestamp));
+        WriteChunk(file, &formatID, sizeof(formatID));
+        WriteChunk(file, &nameID, sizeof(nameID));
+        WriteChunk(file, &argumentsSize, sizeof(argumentsSize));
+        if (argumentsSize)
+            WriteChunk(file, message.Arguments.Data, argumentsSize);
+    }
+
+    bool BinaryLog::IsBinaryLog(BufferView data)
+    {
+        return data.Size >= HeaderSize && memcmp(data.Data, Magic, sizeof(Magic)) == 0;
+    }
+
+    bool BinaryLog::Decode(BufferView data, const std::function<void(const BinaryLogMessage&)>& onMessage)
+    {
+        if (!IsBinaryLog(data))
+            return false;
+
+        ArgumentReader reader = { data.Data, data.Size, sizeof(Magic) };
+        uint16_t version = 0;
+        if (!reader.Read(version) || version != Version)
+            return false;
+
+        std::unordered_map<uint64_t, String> strings;
+        auto lookup = [&](uint64_t id) -> const char*
+        {
+            auto it = strings.find(id);
+            return it != strings.end() ? it->second.c_str() : "<unknown>";
+        };
+
+        while (reader.Offset < reader.Size)
+        {
+            char tag = 0;
+            reader.Read(tag);
+            if (tag == 'S')
+            {
+                uint64_t id = 0;
+                Uint length = 0;
+                if (!reader.Read(id) || !reader.Read(length) || reader.Offset + length > reader.Size)
+                    return false;
+                strings[id].assign((const char*)reader.Data + reader.Offset, length);
+                reader.Offset += length;
+            }
+            else if (tag == 'M')
+            {
+                uint8_t level = 0;
+                uint64_t formatID = 0, nameID = 0;
+                Uint argumentsSize = 0;
+                BinaryLogMessage message;
+                if (!reader.Read(level) || !reader.Read(message.ThreadID) || !reader.Read(message.Timestamp) || !reader.Read(formatID) ||
+                    !reader.Read(nameID) || !reader.Read(argumentsSize) || reader.Offset + argumentsSize > reader.Size)
+                    return false;
+
+                message.Level = (Severity)std::min<uint8_t>(level, (uint8_t)Severity::Critical);
+                message.Format = lookup(formatID);
+                message.Name = lookup(nameID);
+                message.Arguments = BufferView(reader.Data + reader.Offset, argumentsSize);
+                reader.Offset += argumentsSize;
+                onMessage(message);
+            }
+            else
+                return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,53 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Core/Buffer.h"
+#include "Spike/Core/Log.h"
+#include <cstdarg>
+#include <cstdio>
+
+namespace Spike
+{
+    struct BinaryLogMessage
+    {
+        const char* Name = nullptr;
+        const char* Format = nullptr;
+        Severity Level = Severity::Info;
+        Uint ThreadID = 0;
+        int64_t Timestamp = 0; // Nanoseconds since the epoch
+        BufferView Arguments;  // What EncodeArguments wrote for Format
+    };
+
+    /* [Spike] printf with the formatting left for later. A log call copies the raw arguments its format asks for,
+     * somebody turns them into text once the message is actually read: the logging thread for the consoles, the
+     * decoder for binary .spikeLog files.
+     *
+     * File layout, native endianness: the header, then a stream of chunks. A string chunk defines the text behind a
+     * pointer the first time the file sees it (format strings and logger names), a message chunk refers to those by
+     * pointer value. Formats and names are never copied per message, so both have to be string literals [Spike] */
+    class BinaryLog
+    {
+    public:
+        static constexpr char Magic[6] = { 'S', 'P', 'K', 'L', 'O', 'G' };
+        static constexpr uint16_t Version = 1;
+        static constexpr Uint HeaderSize = sizeof(Magic) + sizeof(Version);
+
+        /* [Spike] Copies the arguments format asks for out of args into buffer. Returns the bytes that takes, and only
+         * writes when that fits into capacity, so a second call with a bigger buffer (and a fresh va_list) can follow [Spike] */
+        static Uint EncodeArguments(const char* format, va_list args, byte* buffer, Uint capacity);
+
+        /* [Spike] Appends format with the encoded arguments to out, the same text vsnprintf would have produced [Spike] */
+        static void FormatArguments(const char* format, BufferView arguments, String& out);
+
+        static void WriteHeader(FILE* file);
+        static void WriteString(FILE* file, const char* string);
+        static void WriteMessage(FILE* file, const BinaryLogMessage& message);
+
+        static bool IsBinaryLog(BufferView data);
+
+        /* [Spike] Calls onMessage for every message in a binary log, in the order they were written. The pointers in the
+         * message live until Decode returns. Returns false if the data isn't a binary log or ends in a broken chunk,
+         * everything before that was still handed out [Spike] */
+        static bool Decode(BufferView data, const std::function<void(const BinaryLogMessage&)>& onMessage);
+    };
+}
@@ -3,83 +3,159 @@
 #pragma once
 #include "Log.h"
 #include "Base.h"
+#include <cstddef>
+#include <cstring>
+#include <istream>
+#include <new>
 
 namespace Spike
 {
-    struct Buffer
+    /* [Spike] Non owning view of bytes somebody else keeps alive. Cheap to copy, pass it by value [Spike] */
+    struct BufferView
     {
-        byte* Data;
-        Uint Size;
+        const byte* Data = nullptr;
+        uint64_t Size = 0;
 
-        Buffer()
-            : Data(nullptr), Size(0) {}
+        BufferView() = default;
+        BufferView(const void* data, uint64_t size)
+            : Data((const byte*)data), Size(size) {}
 
-        Buffer(byte* data, Uint size)
-            : Data(data), Size(size) {}
+        template<typename T>
+        BufferView(const Vector<T>& vector)
+            : Data((const byte*)vector.data()), Size(vector.size() * sizeof(T)) {}
 
-        static Buffer Copy(void* data, Uint size)
+        BufferView Slice(uint64_t offset, uint64_t size) const
         {
-            Buffer buffer;
-            buffer.Allocate(size);
-            memcpy(buffer.Data, data, size);
-            return buffer;
+            SPK_CORE_ASSERT(offset + size <= Size, "BufferView slice out of range!");
+            return BufferView(Data + offset, size);
         }
 
-        void Allocate(Uint size)
-        {
-            delete[] Data;
-            Data = nullptr;
+        template<typename T>
+        const T* As() const { return (const T*)Data; }
 
-            if (size == 0) return;
+        operator bool() const { return Data != nullptr; }
+        byte operator[](uint64_t index) const { return Data[index]; }
+        uint64_t GetSize() const { return Size; }
+    };
 
-            Data = new byte[size];
-            Size = size;
+    /* [Spike] Owns its bytes. Move only, hand out a BufferView to lend them without a copy [Spike] */
+    struct Buffer
+    {
+        byte* Data = nullptr;
+        uint64_t Size = 0;
+        uint64_t Alignment = alignof(std::max_align_t);
+
+        Buffer() = default;
+
+        explicit Buffer(uint64_t size, uint64_t alignment = alignof(std::max_align_t))
+        {
+            Allocate(size, alignment);
         }
 
-        void ZeroInitialize()
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+
+        Buffer(Buffer&& other) noexcept
+            : Data(other.Data), Size(other.Size), Alignment(other.Alignment)
         {
-            if (Data)
-                memset(Data, 0, Size);
+            other.Data = nullptr;
+            other.Size = 0;
         }
 
-        template<typename T>
-        T& Read(Uint offset = 0)
+        Buffer& operator=(Buffer&& other) noexcept
         {
-            return *(T*)(Data + offset);
+            if (this != &other)
+            {
+                Release();
+                Data = other.Data;
+                Size = other.Size;
+                Alignment = other.Alignment;
+                other.Data = nullptr;
+                other.Size = 0;
+            }
+            return *this;
         }
 
-        void Write(void* data, Uint size, Uint offset = 0)
+        ~Buffer()
         {
-            SPK_CORE_ASSERT(offset + size <= Size, "Buffer overflow!");
-            memcpy(Data + offset, data, size);
+            Release();
         }
 
-        operator bool()
+        static Buffer Copy(BufferView source, uint64_t alignment = alignof(std::max_align_t))
         {
-            return Data;
+            Buffer buffer(source.Size, alignment);
+            if (source.Size)
+                memcpy(buffer.Data, source.Data, source.Size);
+            return buffer;
         }
 
-        operator bool() const
+        void Allocate(uint64_t size, uint64_t alignment = alignof(std::max_align_t))
         {
-            return Data;
+            Release();
+            Alignment = alignment;
+            if (size == 0)
+                return;
+
+            Data = (byte*)::operator new((size_t)size, std::align_val_t((size_t)alignment));
+            Size = size;
         }
 
-        byte& operator[](int index)
+        void Release()
         {
-            return Data[index];
+            if (Data)
+                ::operator delete(Data, std::align_val_t((size_t)Alignment));
+            Data = nullptr;
+            Size = 0;
         }
 
-        byte operator[](int index) const
+        void ZeroInitialize()
         {
-            return Data[index];
+            if (Data)
+                memset(Data, 0, (size_t)Size);
         }
 
         template<typename T>
-        T* As()
+        T& Read(uint64_t offset = 0)
+        {
+            return *(T*)(Data + offset);
+        }
+
+        void Write(const void* data, uint64_t size, uint64_t offset = 0)
         {
-            return (T*)Data;
+            SPK_CORE_ASSERT(offset + size <= Size, "Buffer overflow!");
+            memcpy(Data + offset, data, (size_t)size);
         }
 
-        Uint GetSize() const { return Size; }
+        operator bool() const { return Data != nullptr; }
+        operator BufferView() const { return GetView(); }
+
+        byte& operator[](uint64_t index) { return Data[index]; }
+        byte operator[](uint64_t index) const { return Data[index]; }
+
+        template<typename T>
+        T* As() { return (T*)Data; }
+        template<typename T>
+        const T* As() const { return (const T*)Data; }
+
+        BufferView GetView() const { return BufferView(Data, Size); }
+        uint64_t GetSize() const { return Size; }
+    };
+
+    /* [Spike] Lets std::istream based parsers (yaml-cpp) read a BufferView in place instead of a copy of it [Spike] */
+    class BufferViewStream : public std::istream
+    {
+    public:
+        BufferViewStream(BufferView view)
+            :std::istream(nullptr), m_StreamBuffer(view) { rdbuf(&m_StreamBuffer); }
+    private:
+        struct ViewStreamBuffer : public std::streambuf
+        {
+            ViewStreamBuffer(BufferView view)
+            {
+                char* begin = (char*)view.Data;
+                setg(begin, begin, begin + view.Size);
+            }
+        };
+        ViewStreamBuffer m_StreamBuffer;
     };
 }
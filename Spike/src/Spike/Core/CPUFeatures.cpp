@@ -0,0 +1,66 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "CPUFeatures.h"
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#else
+    #include <cpuid.h>
+#endif
+
+namespace Spike
+{
+    static void QueryCPUID(int leaf, int subleaf, int registers[4])
+    {
+    #ifdef _MSC_VER
+        __cpuidex(registers, leaf, subleaf);
+    #else
+        __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+    #endif
+    }
+
+    static uint64_t QueryXCR0()
+    {
+    #ifdef _MSC_VER
+        return _xgetbv(0);
+    #else
+        uint32_t eax, edx;
+        __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return ((uint64_t)edx << 32) | eax;
+    #endif
+    }
+
+    static CPUFeatures DetectFeatures()
+    {
+        CPUFeatures features;
+        int registers[4] = {};
+
+        QueryCPUID(0, 0, registers);
+        int maxLeaf = registers[0];
+        if (maxLeaf < 1)
+            return features;
+
+        QueryCPUID(1, 0, registers);
+        const int ecx = registers[2];
+        features.SSE41 = (ecx & (1 << 19)) != 0;
+
+        // OSXSAVE + the OS saving XMM and YMM state, otherwise AVX instructions fault
+        const bool osSavesYMM = (ecx & (1 << 27)) && (QueryXCR0() & 0x6) == 0x6;
+        features.AVX = osSavesYMM && (ecx & (1 << 28));
+        features.FMA = features.AVX && (ecx & (1 << 12));
+
+        if (maxLeaf >= 7)
+        {
+            QueryCPUID(7, 0, registers);
+            features.AVX2 = features.AVX && (registers[1] & (1 << 5));
+        }
+        return features;
+    }
+
+    const CPUFeatures& CPU::GetFeatures()
+    {
+        static CPUFeatures s_Features = DetectFeatures();
+        return s_Features;
+    }
+}
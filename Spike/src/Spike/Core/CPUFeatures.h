@@ -0,0 +1,21 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+
+namespace Spike
+{
+    struct CPUFeatures
+    {
+        bool SSE41 = false;
+        bool AVX = false;
+        bool AVX2 = false;
+        bool FMA = false;
+    };
+
+    class CPU
+    {
+    public:
+        /* [Spike] Queried once through CPUID. AVX/AVX2/FMA are only reported when the OS also saves the YMM registers [Spike] */
+        static const CPUFeatures& GetFeatures();
+    };
+}
@@ -0,0 +1,169 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "FrameAllocator.h"
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+namespace Spike
+{
+    /* [Spike] One frame's worth of memory. Whatever doesn't fit goes to the heap and is freed when the buffer is recycled [Spike] */
+    struct FrameBuffer
+    {
+        byte* Base = nullptr;
+        std::atomic<size_t> Offset = 0;
+
+        std::mutex OverflowMutex;
+        Vector<void*> Overflow;
+        size_t OverflowBytes = 0;
+    };
+
+    /* [Spike] The part of a frame buffer a thread bumps through without touching any shared state [Spike] */
+    struct ThreadBlock
+    {
+        uint64_t Frame = ~0ull;
+        byte* Cursor = nullptr;
+        byte* End = nullptr;
+    };
+
+    static const size_t BlockSize = 64 * 1024;
+
+    static FrameBuffer s_Buffers[2];
+    static size_t s_Capacity = 0;
+    static std::atomic<uint64_t> s_Frame = 0; // The current buffer is s_Buffers[s_Frame & 1]
+    static thread_local ThreadBlock s_ThreadBlock;
+
+    static size_t s_UsedLastFrame = 0;
+    static size_t s_PeakUsed = 0;
+    static size_t s_OverflowLastFrame = 0;
+
+    static byte* AlignUp(byte* pointer, size_t alignment)
+    {
+        return (byte*)(((uintptr_t)pointer + alignment - 1) & ~(uintptr_t)(alignment - 1));
+    }
+
+    static void* AllocateOverflow(FrameBuffer& buffer, size_t size, size_t alignment)
+    {
+        byte* memory = (byte*)malloc(size + alignment);
+        std::lock_guard<std::mutex> lock(buffer.OverflowMutex);
+        buffer.Overflow.push_back(memory);
+        buffer.OverflowBytes += size;
+        return AlignUp(memory, alignment);
+    }
+
+    static byte* Carve(FrameBuffer& buffer, size_t size)
+    {
+        size_t offset = buffer.Offset.fetch_add(size, std::memory_order_relaxed);
+        if (offset + size > s_Capacity)
+            return nullptr;
+        return buffer.Base + offset;
+    }
+
+    static void Recycle(FrameBuffer& buffer)
+    {
+        buffer.Offset.store(0, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(buffer.OverflowMutex);
+        for (void* memory : buffer.Overflow)
+            free(memory);
+        buffer.Overflow.clear();
+        buffer.OverflowBytes = 0;
+    }
+
+    void FrameAllocator::Init(size_t capacityPerFrame)
+    {
+        SPK_CORE_ASSERT(!s_Buffers[0].Base, "FrameAllocator already initialized!");
+        s_Capacity = capacityPerFrame;
+        for (auto& buffer : s_Buffers)
+        {
+            buffer.Base = (byte*)malloc(capacityPerFrame);
+            Recycle(buffer);
+        }
+        s_Frame.fetch_add(1, std::memory_order_release); // Invalidates blocks handed out before Init
+    }
+
+    void FrameAllocator::Shutdown()
+    {
+        for (auto& buffer : s_Buffers)
+        {
+            Recycle(buffer);
+            free(buffer.Base);
+            buffer.Base = nullptr;
+        }
+        s_Capacity = 0;
+        s_Frame.fetch_add(1, std::memory_order_release);
+    }
+
+    void* FrameAllocator::Allocate(size_t size, size_t alignment)
+    {
+        const uint64_t frame = s_Frame.load(std::memory_order_acquire);
+        FrameBuffer& buffer = s_Buffers[frame & 1];
+        if (!buffer.Base)
+            return AllocateOverflow(buffer, size, alignment); // Before Init or after Shutdown
+
+        ThreadBlock& block = s_ThreadBlock;
+        if (block.Frame == frame)
+        {
+            byte* memory = AlignUp(block.Cursor, alignment);
+            if (memory + size <= block.End)
+            {
+                block.Cursor = memory + size;
+                return memory;
+            }
+        }
+
+        // Big requests get a piece of their own, anything else starts a new block for this thread
+        if (size + alignment > BlockSize / 4)
+        {
+            byte* memory = Carve(buffer, size + alignment);
+            return memory ? AlignUp(memory, alignment) : AllocateOverflow(buffer, size, alignment);
+        }
+
+        byte* start = Carve(buffer, BlockSize);
+        if (!start)
+            return AllocateOverflow(buffer, size, alignment);
+
+        byte* memory = AlignUp(start, alignment);
+        block = { frame, memory + size, start + BlockSize };
+        return memory;
+    }
+
+    char* FrameAllocator::CopyString(const char* string, size_t length)
+    {
+        char* copy = (char*)Allocate(length + 1, 1);
+        memcpy(copy, string, length);
+        copy[length] = '\0';
+        return copy;
+    }
+
+    char* FrameAllocator::CopyString(const char* string)
+    {
+        return CopyString(string, strlen(string));
+    }
+
+    void FrameAllocator::EndFrame()
+    {
+        const uint64_t frame = s_Frame.load(std::memory_order_relaxed);
+        FrameBuffer& finished = s_Buffers[frame & 1];
+        s_UsedLastFrame = std::min(finished.Offset.load(std::memory_order_relaxed), s_Capacity);
+        s_OverflowLastFrame = finished.OverflowBytes;
+        s_PeakUsed = std::max(s_PeakUsed, s_UsedLastFrame);
+
+        // The other buffer belongs to the frame before the one that just finished
+        Recycle(s_Buffers[(frame + 1) & 1]);
+        s_Frame.store(frame + 1, std::memory_order_release);
+
+        if (s_OverflowLastFrame)
+            SPK_CORE_LOG_WARN("FrameAllocator: %zu bytes did not fit into the %zu byte frame buffer", s_OverflowLastFrame, s_Capacity);
+    }
+
+    FrameAllocatorStats FrameAllocator::GetStats()
+    {
+        FrameAllocatorStats stats;
+        stats.Capacity = s_Capacity;
+        stats.UsedLastFrame = s_UsedLastFrame;
+        stats.PeakUsed = s_PeakUsed;
+        stats.OverflowLastFrame = s_OverflowLastFrame;
+        return stats;
+    }
+}
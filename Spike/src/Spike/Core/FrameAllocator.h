@@ -0,0 +1,63 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Core/Base.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Spike
+{
+    struct FrameAllocatorStats
+    {
+        size_t Capacity = 0;        // Per frame
+        size_t UsedLastFrame = 0;
+        size_t PeakUsed = 0;        // Highest UsedLastFrame since Init
+        size_t OverflowLastFrame = 0; // Bytes that didn't fit and went to the heap
+    };
+
+    /* [Spike] Memory that lives for the current and the next frame. Allocating is a pointer bump in a block owned by the
+     * calling thread, blocks are carved from the frame's buffer with one atomic add, so jobs can allocate without contending.
+     * Nothing is freed individually, Application::Run calls EndFrame() which recycles the buffer of two frames ago.
+     * Destructors are never run by the allocator itself, containers using FrameStlAllocator still destroy their elements [Spike] */
+    class FrameAllocator
+    {
+    public:
+        static void Init(size_t capacityPerFrame = 8 * 1024 * 1024);
+        static void Shutdown();
+
+        static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        /* [Spike] Null terminated copy of length chars of string, valid until the end of the next frame [Spike] */
+        static char* CopyString(const char* string, size_t length);
+        static char* CopyString(const char* string);
+
+        /* [Spike] Must be called while no job is allocating, Application::Run does it after every layer has been updated [Spike] */
+        static void EndFrame();
+        static FrameAllocatorStats GetStats();
+    };
+
+    template<typename T>
+    class FrameStlAllocator
+    {
+    public:
+        using value_type = T;
+
+        FrameStlAllocator() = default;
+        template<typename U>
+        FrameStlAllocator(const FrameStlAllocator<U>&) {}
+
+        T* allocate(size_t count) { return static_cast<T*>(FrameAllocator::Allocate(count * sizeof(T), alignof(T))); }
+        void deallocate(T*, size_t) {}
+
+        template<typename U>
+        bool operator==(const FrameStlAllocator<U>&) const { return true; }
+        template<typename U>
+        bool operator!=(const FrameStlAllocator<U>&) const { return false; }
+    };
+
+    /* [Spike] Per frame temporaries, don't keep them (or anything pointing into them) past the next frame [Spike] */
+    template<typename T>
+    using FrameVector = std::vector<T, FrameStlAllocator<T>>;
+    using FrameString = std::basic_string<char, std::char_traits<char>, FrameStlAllocator<char>>;
+}
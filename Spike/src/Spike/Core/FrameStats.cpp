@@ -0,0 +1,247 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "FrameStats.h"
+#include "Spike/Core/Application.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace Spike
+{
+    struct SystemHistory
+    {
+        const char* Name;
+        float Current = 0.0f; // Accumulated over the frame that is still running
+        Scope<float[]> Samples; // Same slots as s_FrameTimes, 0 for frames the system didn't run in
+    };
+
+    static float s_FrameTimes[FrameStats::Capacity];
+    static uint64_t s_FrameCount = 0; // Every frame since the last Reset, the ring holds the last Capacity of them
+    static Vector<SystemHistory> s_Systems;
+    static float s_HitchThreshold = 1000.0f / 30.0f;
+
+    static Clock s_FrameClock;
+    static bool s_Started = false;
+
+    static Uint GetStoredFrames() { return (Uint)std::min<uint64_t>(s_FrameCount, FrameStats::Capacity); }
+
+    // Ring slot of the i-th stored frame, oldest first
+    static Uint GetSlot(Uint i) { return (Uint)((s_FrameCount - GetStoredFrames() + i) % FrameStats::Capacity); }
+
+    void FrameStats::EndFrame()
+    {
+        const float milliseconds = s_FrameClock.GetElapsedTime().AsNanoseconds() / 1000000.0f;
+        s_FrameClock.Reset();
+
+        // The first call closes everything from static initialization up to here, that isn't a frame
+        if (!s_Started)
+        {
+            s_Started = true;
+            for (SystemHistory& system : s_Systems)
+                system.Current = 0.0f;
+            return;
+        }
+
+        const Uint slot = (Uint)(s_FrameCount % Capacity);
+        s_FrameTimes[slot] = milliseconds;
+        for (SystemHistory& system : s_Systems)
+        {
+            system.Samples[slot] = system.Current;
+            system.Current = 0.0f;
+        }
+        s_FrameCount++;
+    }
+
+    void FrameStats::RecordSystem(const char* name, float milliseconds)
+    {
+        for (SystemHistory& system : s_Systems)
+        {
+            if (system.Name == name || strcmp(system.Name, name) == 0)
+            {
+                system.Current += milliseconds;
+                return;
+            }
+        }
+
+        SystemHistory system;
+        system.Name = name;
+        system.Current = milliseconds;
+        system.Samples = Scope<float[]>(new float[Capacity]());
+        s_Systems.push_back(std::move(system));
+    }
+
+    void FrameStats::SetHitchThreshold(float milliseconds) { s_HitchThreshold = milliseconds; }
+    float FrameStats::GetHitchThreshold() { return s_HitchThreshold; }
+    Uint FrameStats::GetFrameCount() { return GetStoredFrames(); }
+
+    float FrameStats::GetFrameTime(Uint framesAgo)
+    {
+        const Uint stored = GetStoredFrames();
+        if (framesAgo >= stored)
+            return 0.0f;
+        return s_FrameTimes[GetSlot(stored - 1 - framesAgo)];
+    }
+
+    /* [Spike] Nearest rank percentiles, samples gets sorted [Spike] */
+    static FrameTimeSummary Summarize(const char* name, Vector<float>& samples)
+    {
+        FrameTimeSummary summary;
+        summary.Name = name;
+        if (samples.empty())
+            return summary;
+
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&](float p) { return samples[(size_t)std::max(std::ceil(p * samples.size()) - 1.0f, 0.0f)]; };
+
+        double total = 0.0;
+        for (float sample : samples)
+            total += sample;
+        summary.Mean = (float)(total / samples.size());
+        summary.P50 = percentile(0.50f);
+        summary.P95 = percentile(0.95f);
+        summary.P99 = percentile(0.99f);
+        summary.Max = samples.back();
+        return summary;
+    }
+
+    FrameStatsReport FrameStats::GetReport()
+    {
+        FrameStatsReport report;
+        report.FrameCount = GetStoredFrames();
+        report.HitchThreshold = s_HitchThreshold;
+
+        Vector<float> samples;
+        samples.reserve(report.FrameCount);
+        for (Uint i = 0; i < report.FrameCount; i++)
+        {
+            const float sample = s_FrameTimes[GetSlot(i)];
+            if (sample > s_HitchThreshold)
+                report.HitchCount++;
+            samples.push_back(sample);
+        }
+        report.Frame = Summarize(nullptr, samples);
+
+        // Only over the frames a system ran in, a system that runs in play mode only shouldn't look twice as fast
+        for (const SystemHistory& system : s_Systems)
+        {
+            samples.clear();
+            for (Uint i = 0; i < report.FrameCount; i++)
+            {
+                const float sample = system.Samples[GetSlot(i)];
+                if (sample > 0.0f)
+                    samples.push_back(sample);
+            }
+            report.Systems.push_back(Summarize(system.Name, samples));
+        }
+        return report;
+    }
+
+    void FrameStats::Reset()
+    {
+        s_FrameCount = 0;
+        for (SystemHistory& system : s_Systems)
+            std::fill(system.Samples.get(), system.Samples.get() + Capacity, 0.0f);
+    }
+
+    static FILE* OpenForWriting(const String& filepath)
+    {
+        std::filesystem::path path{ filepath };
+        if (path.has_parent_path())
+            std::filesystem::create_directories(path.parent_path());
+        return fopen(filepath.c_str(), "w");
+    }
+
+    // The names are ours, escaping quotes and backslashes is all it takes for both CSV and JSON
+    static void WriteQuoted(FILE* file, const char* string, char escape)
+    {
+        fputc('"', file);
+        for (const char* c = string; *c; c++)
+        {
+            if (*c == '"' || (*c == '\\' && escape == '\\'))
+                fputc(escape, file);
+            fputc(*c, file);
+        }
+        fputc('"', file);
+    }
+
+    bool FrameStats::ExportCSV(const String& filepath)
+    {
+        FILE* file = OpenForWriting(filepath);
+        if (!file)
+            return false;
+
+        fprintf(file, "Frame,Frame Time (ms)");
+        for (const SystemHistory& system : s_Systems)
+        {
+            fputc(',', file);
+            WriteQuoted(file, system.Name, '"');
+        }
+        fputc('\n', file);
+
+        const Uint stored = GetStoredFrames();
+        for (Uint i = 0; i < stored; i++)
+        {
+            const Uint slot = GetSlot(i);
+            fprintf(file, "%u,%.4f", i, s_FrameTimes[slot]);
+            for (const SystemHistory& system : s_Systems)
+                fprintf(file, ",%.4f", system.Samples[slot]);
+            fputc('\n', file);
+        }
+        fclose(file);
+        return true;
+    }
+
+    static void WriteSummary(FILE* file, const FrameTimeSummary& summary)
+    {
+        fprintf(file, "{");
+        if (summary.Name)
+        {
+            fprintf(file, "\"name\":");
+            WriteQuoted(file, summary.Name, '\\');
+            fprintf(file, ",");
+        }
+        fprintf(file, "\"mean\":%.4f,\"p50\":%.4f,\"p95\":%.4f,\"p99\":%.4f,\"max\":%.4f}", summary.Mean, summary.P50, summary.P95, summary.P99, summary.Max);
+    }
+
+    bool FrameStats::ExportJSON(const String& filepath, const String& label)
+    {
+        FILE* file = OpenForWriting(filepath);
+        if (!file)
+            return false;
+
+        const FrameStatsReport report = GetReport();
+        fprintf(file, "{\n\"label\":");
+        WriteQuoted(file, label.c_str(), '\\');
+        fprintf(file, ",\n\"configuration\":\"%s\",\n\"platform\":\"%s\",\n\"graphicsAPI\":\"%s\",\n", Application::GetConfigurationName(),
+            Application::GetPlatformName(), Application::CurrentGraphicsAPI());
+        fprintf(file, "\"frameCount\":%u,\n\"hitchThreshold\":%.4f,\n\"hitchCount\":%u,\n\"frame\":", report.FrameCount, report.HitchThreshold, report.HitchCount);
+        WriteSummary(file, report.Frame);
+
+        fprintf(file, ",\n\"systems\":[");
+        for (size_t i = 0; i < report.Systems.size(); i++)
+        {
+            fprintf(file, i ? ",\n  " : "\n  ");
+            WriteSummary(file, report.Systems[i]);
+        }
+
+        fprintf(file, "],\n\"frameTimes\":[");
+        for (Uint i = 0; i < report.FrameCount; i++)
+            fprintf(file, i ? ",%.4f" : "%.4f", s_FrameTimes[GetSlot(i)]);
+
+        fprintf(file, "],\n\"systemTimes\":{");
+        for (size_t s = 0; s < s_Systems.size(); s++)
+        {
+            fprintf(file, s ? ",\n  " : "\n  ");
+            WriteQuoted(file, s_Systems[s].Name, '\\');
+            fprintf(file, ":[");
+            for (Uint i = 0; i < report.FrameCount; i++)
+                fprintf(file, i ? ",%.4f" : "%.4f", s_Systems[s].Samples[GetSlot(i)]);
+            fprintf(file, "]");
+        }
+        fprintf(file, "}\n}\n");
+        fclose(file);
+        return true;
+    }
+}
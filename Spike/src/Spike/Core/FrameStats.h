@@ -0,0 +1,68 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Core/Base.h"
+#include "Spike/Utility/Clock.h"
+
+namespace Spike
+{
+    struct FrameTimeSummary
+    {
+        const char* Name = nullptr; // Null for the whole frame
+        float Mean = 0.0f, P50 = 0.0f, P95 = 0.0f, P99 = 0.0f, Max = 0.0f; // Milliseconds
+    };
+
+    struct FrameStatsReport
+    {
+        Uint FrameCount = 0;
+        Uint HitchCount = 0; // Frames longer than the hitch threshold
+        float HitchThreshold = 0.0f;
+        FrameTimeSummary Frame;
+        Vector<FrameTimeSummary> Systems;
+    };
+
+    /* [Spike] Keeps the last Capacity frame times in a ring, together with how long every system took in each of them.
+     * Always on, it costs a clock read per system per frame. Main thread only [Spike] */
+    class FrameStats
+    {
+    public:
+        static constexpr Uint Capacity = 4096;
+
+        /* [Spike] Closes the frame, Application::Run calls it once per frame [Spike] */
+        static void EndFrame();
+
+        /* [Spike] Adds to the time of a system in the current frame. name has to outlive the run (literal or interned) [Spike] */
+        static void RecordSystem(const char* name, float milliseconds);
+
+        static void SetHitchThreshold(float milliseconds);
+        static float GetHitchThreshold();
+
+        static Uint GetFrameCount(); // Frames currently stored, at most Capacity
+        static float GetFrameTime(Uint framesAgo); // 0 is the last finished frame
+
+        /* [Spike] Percentiles over every stored frame. Sorts copies of the samples, so not something to call every frame
+         * with a full ring [Spike] */
+        static FrameStatsReport GetReport();
+        static void Reset();
+
+        /* [Spike] One row per stored frame, oldest first, a column per system [Spike] */
+        static bool ExportCSV(const String& filepath);
+        /* [Spike] The report plus the build it came from and every sample. label names the run, a scene for example [Spike] */
+        static bool ExportJSON(const String& filepath, const String& label = "");
+    };
+
+    /* [Spike] Records the time until the end of the scope under name [Spike] */
+    class FrameSystemTimer
+    {
+    public:
+        FrameSystemTimer(const char* name)
+            :m_Name(name) {}
+        ~FrameSystemTimer() { FrameStats::RecordSystem(m_Name, m_Clock.GetElapsedTime().AsNanoseconds() / 1000000.0f); }
+
+        FrameSystemTimer(const FrameSystemTimer&) = delete;
+        FrameSystemTimer& operator=(const FrameSystemTimer&) = delete;
+    private:
+        const char* m_Name;
+        Clock m_Clock;
+    };
+}
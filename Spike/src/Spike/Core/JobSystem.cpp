@@ -0,0 +1,417 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "JobSystem.h"
+#include "Spike/Core/MemoryTracker.h"
+#include "Spike/Core/Profiler.h"
+#include "Spike/Utility/Clock.h"
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace Spike
+{
+    struct Job
+    {
+        JobFunction Function;
+        JobCounter* Counter = nullptr;
+        MemoryTag Tag = MemoryTag::Untagged; // Of the thread that queued it
+        std::atomic<bool> InUse = false;
+    };
+
+    /* [Spike] Chase-Lev deque. The owner pushes and pops at the bottom, every other thread steals from the top [Spike] */
+    class JobQueue
+    {
+    public:
+        static const int64_t Capacity = 4096;
+
+        bool Push(Job* job)
+        {
+            int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+            int64_t top = m_Top.load(std::memory_order_acquire);
+            if (bottom - top >= Capacity)
+                return false;
+
+            m_Jobs[bottom & (Capacity - 1)].store(job, std::memory_order_relaxed);
+            m_Bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        Job* Pop()
+        {
+            int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+            m_Bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = m_Top.load(std::memory_order_relaxed);
+
+            if (top > bottom)
+            {
+                // Empty
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Job* job = m_Jobs[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // Last job, race the thieves for it
+                if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                    job = nullptr;
+                m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        Job* Steal()
+        {
+            int64_t top = m_Top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+            if (top >= bottom)
+                return nullptr;
+
+            Job* job = m_Jobs[top & (Capacity - 1)].load(std::memory_order_relaxed);
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                return nullptr; // Lost the race
+            return job;
+        }
+
+        int64_t GetSize() const { return m_Bottom.load(std::memory_order_relaxed) - m_Top.load(std::memory_order_relaxed); }
+    private:
+        alignas(64) std::atomic<int64_t> m_Top = 0;
+        alignas(64) std::atomic<int64_t> m_Bottom = 0;
+        std::atomic<Job*> m_Jobs[Capacity] = {};
+    };
+
+    /* [Spike] Everything a thread owns. Jobs are allocated from a ring that only the owner allocates from, a slot is free
+     * again as soon as whichever thread ran the job clears InUse. The ring is twice the deque, so while the deque has room
+     * a free slot is never far away [Spike] */
+    struct JobThreadData
+    {
+        static const Uint PoolSize = (Uint)JobQueue::Capacity * 2;
+
+        JobQueue Queue;
+        Job Pool[PoolSize];
+        Uint PoolNext = 0;
+        std::thread Thread;
+    };
+
+    static const Uint InvalidThreadIndex = ~0u;
+    static thread_local Uint s_ThreadIndex = InvalidThreadIndex; // 0 = main thread
+
+    static Vector<Scope<JobThreadData>> s_Threads;
+    static std::atomic<bool> s_Running = false;
+    static std::atomic<Uint> s_QueuedJobs = 0;
+    static std::mutex s_SleepMutex;
+    static std::condition_variable s_SleepCondition;
+
+    static std::mutex s_MainThreadMutex;
+    static Vector<std::pair<JobFunction, JobCounter*>> s_MainThreadJobs;
+
+    void JobSystem::FinishJob(JobCounter* counter)
+    {
+        if (counter)
+            counter->m_Pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void JobSystem::Execute(Job* job)
+    {
+        s_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        {
+            MemoryTagScope tag(job->Tag);
+            job->Function();
+        }
+        JobCounter* counter = job->Counter;
+        job->InUse.store(false, std::memory_order_release);
+        FinishJob(counter);
+    }
+
+    static Job* AllocateJob(JobThreadData& thread)
+    {
+        for (Uint attempt = 0; attempt < JobThreadData::PoolSize; attempt++)
+        {
+            Job& job = thread.Pool[thread.PoolNext];
+            thread.PoolNext = (thread.PoolNext + 1) & (JobThreadData::PoolSize - 1);
+            if (!job.InUse.load(std::memory_order_acquire))
+            {
+                job.InUse.store(true, std::memory_order_relaxed);
+                return &job;
+            }
+        }
+        return nullptr;
+    }
+
+    /* [Spike] The own deque first, then the others starting at a different one for every thread [Spike] */
+    static Job* FindJob(Uint threadIndex)
+    {
+        if (Job* job = s_Threads[threadIndex]->Queue.Pop())
+            return job;
+
+        const Uint threadCount = (Uint)s_Threads.size();
+        for (Uint i = 1; i < threadCount; i++)
+        {
+            if (Job* job = s_Threads[(threadIndex + i) % threadCount]->Queue.Steal())
+                return job;
+        }
+        return nullptr;
+    }
+
+    void JobSystem::WorkerMain(Uint threadIndex)
+    {
+        s_ThreadIndex = threadIndex;
+        Profiler::SetThreadName("Job Worker " + std::to_string(threadIndex));
+        while (s_Running.load(std::memory_order_acquire))
+        {
+            if (Job* job = FindJob(threadIndex))
+            {
+                Execute(job);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(s_SleepMutex);
+            s_SleepCondition.wait_for(lock, std::chrono::milliseconds(1), []
+            {
+                return s_QueuedJobs.load(std::memory_order_relaxed) > 0 || !s_Running.load(std::memory_order_relaxed);
+            });
+        }
+    }
+
+    void JobSystem::Init(Uint workerCount)
+    {
+        SPK_CORE_ASSERT(s_Threads.empty(), "JobSystem already initialized!");
+        if (workerCount == 0)
+            workerCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+
+        s_ThreadIndex = 0;
+        s_Running = true;
+        for (Uint i = 0; i <= workerCount; i++)
+            s_Threads.push_back(CreateScope<JobThreadData>());
+        for (Uint i = 1; i <= workerCount; i++)
+            s_Threads[i]->Thread = std::thread(WorkerMain, i);
+
+        SPK_CORE_LOG_INFO("JobSystem: %u worker threads", workerCount);
+    }
+
+    void JobSystem::Shutdown()
+    {
+        // Drain whatever is left, so no counter is left waiting
+        if (!s_Threads.empty())
+        {
+            while (Job* job = FindJob(0))
+                Execute(job);
+        }
+        PumpMainThreadJobs();
+
+        s_Running = false;
+        s_SleepCondition.notify_all();
+        for (auto& thread : s_Threads)
+        {
+            if (thread->Thread.joinable())
+                thread->Thread.join();
+        }
+        s_Threads.clear();
+    }
+
+    bool JobSystem::IsInitialized() { return !s_Threads.empty(); }
+    Uint JobSystem::GetWorkerCount() { return s_Threads.empty() ? 0 : (Uint)s_Threads.size() - 1; }
+    bool JobSystem::IsMainThread() { return s_ThreadIndex == 0; }
+
+    void JobSystem::Run(JobFunction job, JobCounter* counter)
+    {
+        if (!IsInitialized())
+        {
+            job();
+            return;
+        }
+
+        SPK_CORE_ASSERT(s_ThreadIndex != InvalidThreadIndex, "JobSystem::Run must be called from the main thread or a job!");
+        if (counter)
+            counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+        JobThreadData& thread = *s_Threads[s_ThreadIndex];
+        Job* slot = thread.Queue.GetSize() < JobQueue::Capacity ? AllocateJob(thread) : nullptr;
+        if (slot)
+        {
+            slot->Function = std::move(job);
+            slot->Counter = counter;
+            slot->Tag = MemoryTracker::GetCurrentTag();
+            s_QueuedJobs.fetch_add(1, std::memory_order_relaxed);
+            if (thread.Queue.Push(slot))
+            {
+                s_SleepCondition.notify_one();
+                return;
+            }
+            s_QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            job = std::move(slot->Function);
+            slot->InUse.store(false, std::memory_order_release);
+        }
+
+        // Out of room, just run it here
+        job();
+        FinishJob(counter);
+    }
+
+    void JobSystem::RunOnMainThread(JobFunction job, JobCounter* counter)
+    {
+        if (counter)
+            counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(s_MainThreadMutex);
+        s_MainThreadJobs.emplace_back(std::move(job), counter);
+    }
+
+    void JobSystem::PumpMainThreadJobs()
+    {
+        // Without a JobSystem there is no main thread to tell apart, whoever waits runs them
+        SPK_CORE_ASSERT(IsMainThread() || !IsInitialized(), "Main thread jobs can only be pumped from the main thread!");
+        Vector<std::pair<JobFunction, JobCounter*>> jobs;
+        {
+            std::lock_guard<std::mutex> lock(s_MainThreadMutex);
+            jobs.swap(s_MainThreadJobs);
+        }
+
+        for (auto& [job, counter] : jobs)
+        {
+            job();
+            FinishJob(counter);
+        }
+    }
+
+    void JobSystem::Wait(JobCounter& counter)
+    {
+        if (!IsInitialized())
+        {
+            // Run() finished its jobs inline, only main thread ones can be left
+            while (!counter.IsDone())
+                PumpMainThreadJobs();
+            return;
+        }
+
+        SPK_CORE_ASSERT(s_ThreadIndex != InvalidThreadIndex, "JobSystem::Wait must be called from the main thread or a job!");
+        while (!counter.IsDone())
+        {
+            if (Job* job = FindJob(s_ThreadIndex))
+                Execute(job);
+            else if (IsMainThread())
+                PumpMainThreadJobs();
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    static void RunRange(Uint begin, Uint end, Uint grain, const std::function<void(Uint, Uint)>* body, JobCounter* counter)
+    {
+        // Hand the upper halves to whoever is free, keep the lowest part
+        while (end - begin > grain)
+        {
+            Uint middle = begin + (end - begin) / 2;
+            JobSystem::Run([middle, end, grain, body, counter]() { RunRange(middle, end, grain, body, counter); }, counter);
+            end = middle;
+        }
+        (*body)(begin, end);
+    }
+
+    void JobSystem::ParallelFor(Uint count, const std::function<void(Uint, Uint)>& body, Uint minGrain)
+    {
+        if (count == 0)
+            return;
+
+        Uint grain = std::max(std::max(minGrain, 1u), count / (8 * GetThreadCount()));
+        if (count <= grain || GetWorkerCount() == 0)
+        {
+            body(0, count);
+            return;
+        }
+
+        JobCounter counter;
+        RunRange(0, count, grain, &body, &counter);
+        Wait(counter);
+    }
+
+    //// Benchmark /////////////////////////////////////////////////////////////////////
+
+    /* [Spike] What the JobSystem is compared against: one queue, one mutex, one condition variable [Spike] */
+    class NaiveThreadPool
+    {
+    public:
+        NaiveThreadPool(Uint threadCount)
+        {
+            for (Uint i = 0; i < threadCount; i++)
+            {
+                m_Threads.emplace_back([this]()
+                {
+                    while (true)
+                    {
+                        JobFunction job;
+                        {
+                            std::unique_lock<std::mutex> lock(m_Mutex);
+                            m_Condition.wait(lock, [this]() { return !m_Jobs.empty() || m_Stop; });
+                            if (m_Stop && m_Jobs.empty())
+                                return;
+                            job = std::move(m_Jobs.front());
+                            m_Jobs.pop();
+                        }
+                        job();
+                    }
+                });
+            }
+        }
+
+        ~NaiveThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Stop = true;
+            }
+            m_Condition.notify_all();
+            for (auto& thread : m_Threads)
+                thread.join();
+        }
+
+        void Run(JobFunction job)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Jobs.push(std::move(job));
+            }
+            m_Condition.notify_one();
+        }
+    private:
+        Vector<std::thread> m_Threads;
+        std::queue<JobFunction> m_Jobs;
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        bool m_Stop = false;
+    };
+
+    JobSystemBenchmark JobSystem::BenchmarkScheduling(Uint jobCount)
+    {
+        SPK_CORE_ASSERT(IsMainThread(), "The scheduling benchmark has to run on the main thread!");
+        JobSystemBenchmark result;
+        result.JobCount = jobCount;
+        result.ThreadCount = GetThreadCount();
+
+        std::atomic<Uint> executed = 0;
+        {
+            Clock clock;
+            JobCounter counter;
+            for (Uint i = 0; i < jobCount; i++)
+                Run([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+            Wait(counter);
+            result.JobSystemMilliseconds = clock.GetElapsedTime().AsNanoseconds() / 1000000.0;
+        }
+
+        executed = 0;
+        {
+            NaiveThreadPool pool(GetThreadCount());
+            Clock clock;
+            for (Uint i = 0; i < jobCount; i++)
+                pool.Run([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); });
+            while (executed.load(std::memory_order_acquire) < jobCount)
+                std::this_thread::yield();
+            result.NaivePoolMilliseconds = clock.GetElapsedTime().AsNanoseconds() / 1000000.0;
+        }
+        return result;
+    }
+}
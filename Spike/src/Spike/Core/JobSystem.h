@@ -0,0 +1,69 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Core/Base.h"
+#include <atomic>
+#include <functional>
+
+namespace Spike
+{
+    using JobFunction = std::function<void()>;
+    struct Job;
+
+    /* [Spike] Counts the unfinished jobs it was handed to. JobSystem::Wait() keeps running other jobs until it drops to zero [Spike] */
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+    private:
+        std::atomic<Uint> m_Pending = 0;
+        friend class JobSystem;
+    };
+
+    struct JobSystemBenchmark
+    {
+        Uint JobCount = 0;
+        Uint ThreadCount = 0;
+        double JobSystemMilliseconds = 0.0;
+        double NaivePoolMilliseconds = 0.0; // One mutex protected queue shared by all threads
+    };
+
+    /* [Spike] Worker threads with one lock free work stealing deque each. The main thread owns a deque too, so it can run
+     * jobs while it waits. Anything that has to touch the graphics context or Mono goes through RunOnMainThread() [Spike] */
+    class JobSystem
+    {
+    public:
+        static void Init(Uint workerCount = 0); // 0 = one worker per hardware thread, minus the main thread
+        static void Shutdown();
+
+        static bool IsInitialized();
+        static Uint GetWorkerCount();
+        static Uint GetThreadCount() { return GetWorkerCount() + 1; }
+        static bool IsMainThread();
+
+        /* [Spike] Must be called from the main thread or from inside a job. Runs the job right away if the JobSystem
+         * isn't initialized, so tools can use code built on it without starting workers [Spike] */
+        static void Run(JobFunction job, JobCounter* counter = nullptr);
+
+        /* [Spike] Can be called from any thread. The job runs on the main thread in the next Wait() or PumpMainThreadJobs() [Spike] */
+        static void RunOnMainThread(JobFunction job, JobCounter* counter = nullptr);
+        static void PumpMainThreadJobs();
+
+        static void Wait(JobCounter& counter);
+
+        /* [Spike] Calls body(begin, end) over [0, count) and returns when every range is done. Ranges are split in halves
+         * while they are bigger than the grain, which defaults to count / (8 * threads) and never goes below minGrain [Spike] */
+        static void ParallelFor(Uint count, const std::function<void(Uint, Uint)>& body, Uint minGrain = 1);
+
+        /* [Spike] Runs jobCount empty jobs through the JobSystem and through a naive pool with the same thread count [Spike] */
+        static JobSystemBenchmark BenchmarkScheduling(Uint jobCount = 100000);
+    private:
+        static void WorkerMain(Uint threadIndex);
+        static void Execute(Job* job);
+        static void FinishJob(JobCounter* counter);
+    };
+}
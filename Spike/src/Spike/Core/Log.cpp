@@ -2,162 +2,611 @@
 //Copyright 2021 - SpikeTechnologies - All Rights Reserved
 #include "spkpch.h"
 #include "Spike/Core/Log.h"
+#include "Spike/Core/BinaryLog.h"
+#include "Spike/Core/LogRingFile.h"
+#include "Spike/Core/Profiler.h"
 #include "Panels/ConsolePanel.h"
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
 #include <cstring>
 #include <ctime>
 #include <filesystem>
+#include <mutex>
 #include <stdarg.h>
 #include <stdio.h>
+#include <thread>
 
 namespace Spike
 {
     Logger Logger::s_CoreLogger = Logger("Spike");
-    std::vector<std::string>     Logger::s_Buffer;
 
-    bool Logger::s_LogToFile = false;
-    bool Logger::s_LogToConsole = true;
-    bool Logger::s_LogToEditorConsole = true;
+    std::atomic<bool> Logger::s_LogToFile = false;
+    std::atomic<bool> Logger::s_LogToConsole = true;
+    std::atomic<bool> Logger::s_LogToEditorConsole = true;
+    std::atomic<LogFileFormat> Logger::s_FileFormat = LogFileFormat::Text;
+    std::atomic<uint64_t> Logger::s_RingFileSize = 16 * 1024 * 1024;
 
     const char* Logger::s_PreviousFile = "Logs/SpikeEngine-CurrentLogs.spikeLog";
     const char* Logger::s_CurrentFile = "Logs/SpikeEngine-Logs.spikeLog";
 
-    Logger::Logger(const char* name)
-        : m_Name(name) {}
+    static std::mutex s_CategoryMutex;
+
+    static Vector<LogCategory*>& GetCategoryList()
+    {
+        // Loggers are mostly statics, this has to exist before the first of them is constructed
+        static Vector<LogCategory*>* categories = new Vector<LogCategory*>();
+        return *categories;
+    }
+
+    static LogCategory* GetCategory(const char* name, Severity threshold)
+    {
+        std::lock_guard<std::mutex> lock(s_CategoryMutex);
+        for (LogCategory* category : GetCategoryList())
+            if (category->Name == name)
+                return category;
+
+        LogCategory* category = new LogCategory();
+        category->Name = name;
+        category->Threshold = threshold;
+        GetCategoryList().push_back(category);
+        return category;
+    }
+
+    Logger::Logger(const char* name, Severity threshold)
+        : m_Category(GetCategory(name, threshold)) {}
+
+    void Logger::SetThreshold(const char* category, Severity threshold)
+    {
+        GetCategory(category, threshold)->Threshold = threshold;
+    }
+
+    Vector<LogCategory*> Logger::GetCategories()
+    {
+        std::lock_guard<std::mutex> lock(s_CategoryMutex);
+        return GetCategoryList();
+    }
 
     void Logger::Log(Severity severity, const char* format, ...)
     {
+        if (!IsEnabled(severity))
+            return;
         va_list args;
         va_start(args, format);
-        Logger::Log(this->m_Name, severity, format, args);
+        Logger::Log(GetName(), severity, format, args);
         va_end(args);
     }
 
     void Logger::LogTrace(const char* format, ...)
     {
+        if (!IsEnabled(Severity::Trace))
+            return;
         va_list args;
         va_start(args, format);
-        Logger::Log(this->m_Name, Severity::Trace, format, args);
+        Logger::Log(GetName(), Severity::Trace, format, args);
         va_end(args);
     }
 
     void Logger::LogInfo(const char* format, ...)
     {
+        if (!IsEnabled(Severity::Info))
+            return;
         va_list args;
         va_start(args, format);
-        Logger::Log(this->m_Name, Severity::Info, format, args);
+        Logger::Log(GetName(), Severity::Info, format, args);
         va_end(args);
     }
     void Logger::LogDebug(const char* format, ...)
     {
+        if (!IsEnabled(Severity::Debug))
+            return;
         va_list args;
         va_start(args, format);
-        Logger::Log(this->m_Name, Severity::Debug, format, args);
+        Logger::Log(GetName(), Severity::Debug, format, args);
         va_end(args);
     }
 
     void Logger::LogWarning(const char* format, ...)
     {
+        if (!IsEnabled(Severity::Warning))
+            return;
         va_list args;
         va_start(args, format);
-        Logger::Log(this->m_Name, Severity::Warning, format, args);
+        Logger::Log(GetName(), Severity::Warning, format, args);
         va_end(args);
     }
 
     void Logger::LogError(const char* format, ...)
     {
+        if (!IsEnabled(Severity::Error))
+            return;
         va_list args;
         va_start(args, format);
-        Logger::Log(this->m_Name, Severity::Error, format, args);
+        Logger::Log(GetName(), Severity::Error, format, args);
         va_end(args);
     }
 
     void Logger::LogCritical(const char* format, ...)
     {
+        if (!IsEnabled(Severity::Critical))
+            return;
         va_list args;
         va_start(args, format);
-        Logger::Log(this->m_Name, Severity::Critical, format, args);
+        Logger::Log(GetName(), Severity::Critical, format, args);
         va_end(args);
     }
 
-    void Logger::Init()
+    /* [Spike] One slot of the queue. Sequence says whose turn it is (Vyukov's bounded queue): position when a producer
+     * may claim it, position + 1 once the message is in, position + Capacity once the logging thread is done with it [Spike] */
+    struct LogRecord
     {
-        if (std::filesystem::exists(Logger::s_CurrentFile))
+        static constexpr Uint InlineSize = 224;
+
+        std::atomic<uint64_t> Sequence = 0;
+        const char* Name = nullptr;
+        const char* Format = nullptr;
+        Severity Level = Severity::Info;
+        Uint ThreadID = 0;
+        int64_t Timestamp = 0; // Nanoseconds since the epoch
+        Uint Size = 0;         // Of the encoded arguments
+        byte* Overflow = nullptr; // Arguments that don't fit Inline, malloc'd by the producer, freed by the consumer
+        bool InRing = false;      // Already in the ring file, appended by the thread that logged it
+        byte Inline[InlineSize];
+
+        BufferView GetArguments() const { return BufferView(Overflow ? Overflow : Inline, Size); }
+
+        BinaryLogMessage ToBinaryMessage() const
         {
-            if (std::filesystem::exists(Logger::s_PreviousFile))
-                std::filesystem::remove(Logger::s_PreviousFile);
+            BinaryLogMessage message;
+            message.Name = Name;
+            message.Format = Format;
+            message.Level = Level;
+            message.ThreadID = ThreadID;
+            message.Timestamp = Timestamp;
+            message.Arguments = GetArguments();
+            return message;
+        }
+    };
 
-            if (rename(Logger::s_CurrentFile, Logger::s_PreviousFile))
-                Logger("Logger").Log(Severity::Debug, "Failed to rename log file %s to %s", Logger::s_CurrentFile, Logger::s_PreviousFile);
+    struct LogBackend
+    {
+        static constexpr Uint Capacity = 2048;
+        static constexpr Uint Mask = Capacity - 1;
+        static_assert((Capacity & Mask) == 0, "Capacity must be a power of two!");
+
+        static LogRecord* Records;
+        static std::atomic<uint64_t> EnqueuePosition;
+        static uint64_t DequeuePosition; // Only touched by whoever holds ConsumerMutex
+        static std::atomic<uint64_t> WrittenPosition;
+        static std::atomic<uint64_t> Dropped;
+        static std::atomic<LogQueuePolicy> Policy;
+
+        static std::thread Thread;
+        static std::thread::id ThreadID;
+        static std::atomic<bool> Running;
+        static std::atomic<bool> Sleeping;
+        static std::mutex SleepMutex;
+        static std::condition_variable SleepCondition;
+
+        // Held while messages are written out, by the logging thread or by a writer on another thread when it isn't running
+        static std::recursive_mutex ConsumerMutex;
+        static FILE* File;
+        static LogFileFormat FileFormat; // Of the open file, latched when it was opened
+        static std::unordered_set<const char*> FileStrings; // Formats and names the binary file already defines
+        static std::atomic<LogRingFile*> Ring; // Open while FileFormat is Ring, log calls append to it without any lock
+        static std::atomic<Uint> RingWriters;
+        static String Message;
+        static std::time_t CachedTime;
+        static char CachedTimeString[16];
+
+        static bool TryEnqueue(const char* name, Severity severity, const char* format, va_list args);
+        static void Fill(LogRecord& record, const char* name, Severity severity, const char* format, va_list args);
+        static bool Drain();
+        static void Write(const LogRecord& record);
+        static void WriteBinary(const LogRecord& record);
+        static bool AppendToRing(const LogRecord& record);
+        static bool OpenFile();
+        static void CloseFile();
+        static void FlushFile();
+        static void WakeUp();
+        static void ThreadMain();
+        static void OnCrash();
+    };
+
+    LogRecord*                  LogBackend::Records = nullptr;
+    std::atomic<uint64_t>       LogBackend::EnqueuePosition = 0;
+    uint64_t                    LogBackend::DequeuePosition = 0;
+    std::atomic<uint64_t>       LogBackend::WrittenPosition = 0;
+    std::atomic<uint64_t>       LogBackend::Dropped = 0;
+    std::atomic<LogQueuePolicy> LogBackend::Policy = LogQueuePolicy::Block;
+    std::thread                 LogBackend::Thread;
+    std::thread::id             LogBackend::ThreadID;
+    std::atomic<bool>           LogBackend::Running = false;
+    std::atomic<bool>           LogBackend::Sleeping = false;
+    std::mutex                  LogBackend::SleepMutex;
+    std::condition_variable     LogBackend::SleepCondition;
+    std::recursive_mutex        LogBackend::ConsumerMutex;
+    FILE*                       LogBackend::File = nullptr;
+    LogFileFormat               LogBackend::FileFormat = LogFileFormat::Text;
+    std::unordered_set<const char*> LogBackend::FileStrings;
+    std::atomic<LogRingFile*>   LogBackend::Ring = nullptr;
+    std::atomic<Uint>           LogBackend::RingWriters = 0;
+    String                      LogBackend::Message;
+    std::time_t                 LogBackend::CachedTime = 0;
+    char                        LogBackend::CachedTimeString[16] = "";
+
+    static Uint GetLogThreadID()
+    {
+        static std::atomic<Uint> s_NextThreadID = 1;
+        static thread_local Uint s_ThreadID = s_NextThreadID++;
+        return s_ThreadID;
+    }
+
+    void LogBackend::Fill(LogRecord& record, const char* name, Severity severity, const char* format, va_list args)
+    {
+        record.Name = name;
+        record.Format = format;
+        record.Level = severity;
+        record.ThreadID = GetLogThreadID();
+        record.Timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        record.Overflow = nullptr;
+        record.InRing = false;
+
+        // No formatting here, only the raw arguments. A second pass only for the rare message that doesn't fit
+        record.Size = BinaryLog::EncodeArguments(format, args, record.Inline, LogRecord::InlineSize);
+        if (record.Size > LogRecord::InlineSize)
+        {
+            record.Overflow = (byte*)malloc(record.Size);
+            if (record.Overflow)
+                BinaryLog::EncodeArguments(format, args, record.Overflow, record.Size);
+            else
+                record.Size = 0;
         }
     }
 
-    void Logger::Shutdown()
+    bool LogBackend::TryEnqueue(const char* name, Severity severity, const char* format, va_list args)
     {
-        Flush();
+        uint64_t position = EnqueuePosition.load(std::memory_order_relaxed);
+        LogRecord* record = nullptr;
+        for (;;)
+        {
+            record = &Records[position & Mask];
+            const int64_t difference = (int64_t)(record->Sequence.load(std::memory_order_acquire) - position);
+            if (difference == 0)
+            {
+                if (EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (difference < 0)
+            {
+                // Full
+                if (Policy.load(std::memory_order_relaxed) == LogQueuePolicy::Drop && severity < Severity::Error)
+                {
+                    Dropped.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                if (!Running.load(std::memory_order_acquire))
+                    return false;
+
+                WakeUp();
+                std::this_thread::yield();
+                position = EnqueuePosition.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                position = EnqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+
+        Fill(*record, name, severity, format, args);
+        record->InRing = AppendToRing(*record);
+        record->Sequence.store(position + 1, std::memory_order_release);
+        // Only the first producer after the logging thread went to sleep pays for the wake up
+        if (Sleeping.load(std::memory_order_relaxed) && Sleeping.exchange(false, std::memory_order_relaxed))
+            WakeUp();
+        return true;
     }
 
-    void Logger::Flush()
+    bool LogBackend::Drain()
     {
-        if (!Logger::s_LogToFile)
-            return;
+        std::lock_guard<std::recursive_mutex> lock(ConsumerMutex);
+        bool wrote = false;
+        for (;;)
+        {
+            LogRecord& record = Records[DequeuePosition & Mask];
+            if (record.Sequence.load(std::memory_order_acquire) != DequeuePosition + 1)
+                break;
+
+            Write(record);
+            free(record.Overflow);
+            record.Overflow = nullptr;
+            record.Sequence.store(DequeuePosition + Capacity, std::memory_order_release);
+            DequeuePosition++;
+            WrittenPosition.store(DequeuePosition, std::memory_order_release);
+            wrote = true;
+        }
+        if (wrote)
+            FlushFile();
+        return wrote;
+    }
+
+    bool LogBackend::OpenFile()
+    {
+        if (File || Ring.load(std::memory_order_relaxed))
+            return true;
 
         std::filesystem::path filepath{ Logger::s_CurrentFile };
         std::filesystem::create_directories(filepath.parent_path());
-
-        FILE* file = fopen(Logger::s_CurrentFile, "a");
-        if (file)
+        FileFormat = Logger::s_FileFormat;
+        if (FileFormat == LogFileFormat::Ring)
         {
-            for (auto message : Logger::s_Buffer)
-                fwrite(message.c_str(), sizeof(char), message.length(), file);
-            fclose(file);
-            Logger::s_Buffer.clear();
+            LogRingFile* ring = new LogRingFile();
+            if (!ring->Open(Logger::s_CurrentFile, Logger::s_RingFileSize))
+            {
+                delete ring;
+                Logger::s_LogToFile = false;
+                return false;
+            }
+            Ring.store(ring);
+            return true;
         }
-        else
+
+        File = fopen(Logger::s_CurrentFile, FileFormat == LogFileFormat::Binary ? "ab" : "a");
+        if (!File)
         {
             Logger::s_LogToFile = false;
+            return false;
         }
+
+        FileStrings.clear();
+        if (FileFormat == LogFileFormat::Binary && ftell(File) == 0)
+            BinaryLog::WriteHeader(File);
+        return true;
     }
 
-    Uint Logger::GetSeverityMaxBufferCount(Severity severity)
+    void LogBackend::CloseFile()
     {
-        switch (severity)
+        if (File)
+            fclose(File);
+        File = nullptr;
+
+        if (LogRingFile* ring = Ring.exchange(nullptr))
         {
-            case Severity::Trace:
-                return 100;
-            case Severity::Info:
-                return 100;
-            case Severity::Debug:
-                return 50;
-            case Severity::Warning:
-                return 10;
-            case Severity::Error:
-                return 0;
-            case Severity::Critical:
-                return 0;
+            // Log calls that picked the ring up before it was taken away may still be writing into the mapping
+            while (RingWriters.load() != 0)
+                std::this_thread::yield();
+            delete ring;
         }
-        return 0;
     }
 
-    const char* Logger::GetSeverityID(Severity severity)
+    void LogBackend::WriteBinary(const LogRecord& record)
     {
-        switch (severity)
+        for (const char* string : { record.Format, record.Name })
+            if (FileStrings.insert(string).second)
+                BinaryLog::WriteString(File, string);
+
+        BinaryLog::WriteMessage(File, record.ToBinaryMessage());
+    }
+
+    bool LogBackend::AppendToRing(const LogRecord& record)
+    {
+        // A single load while there is no ring, which is the usual case
+        if (!Ring.load(std::memory_order_relaxed) || !Logger::s_LogToFile.load(std::memory_order_relaxed))
+            return false;
+
+        // Counted, so CloseFile knows when the last writer is out of the mapping
+        RingWriters.fetch_add(1);
+        LogRingFile* ring = Ring.load();
+        const bool appended = ring && ring->Append(record.ToBinaryMessage());
+        RingWriters.fetch_sub(1);
+        return appended;
+    }
+
+    void LogBackend::Write(const LogRecord& record)
+    {
+        const bool toFile = Logger::s_LogToFile.load(std::memory_order_relaxed) && OpenFile();
+        const bool toTextFile = toFile && FileFormat == LogFileFormat::Text;
+        const bool toConsole = Logger::s_LogToConsole.load(std::memory_order_relaxed);
+        const bool toEditorConsole = Logger::s_LogToEditorConsole.load(std::memory_order_relaxed);
+        if (toFile && FileFormat == LogFileFormat::Binary)
+            WriteBinary(record);
+        // Messages logged before the ring was opened
+        else if (toFile && FileFormat == LogFileFormat::Ring && !record.InRing)
+            AppendToRing(record);
+        if (!toTextFile && !toConsole && !toEditorConsole)
+            return;
+
+        const std::time_t time = (std::time_t)(record.Timestamp / 1000000000);
+        if (time != CachedTime || !CachedTimeString[0])
         {
-            case Severity::Trace:
-                return "TRACE";
-            case Severity::Info:
-                return "INFO";
-            case Severity::Debug:
-                return "DEBUG";
-            case Severity::Warning:
-                return "WARNING";
-            case Severity::Error:
-                return "ERROR";
-            case  Severity::Critical:
-                return "CRITICAL";
+            CachedTime = time;
+            if (!std::strftime(CachedTimeString, sizeof(CachedTimeString), "[%H:%M:%S]", std::localtime(&CachedTime)))
+                CachedTimeString[0] = '\0';
         }
-        return "Unknown Severity";
+
+        // The only place a message gets formatted, off the thread that logged it
+        Message.clear();
+        BinaryLog::FormatArguments(record.Format, record.GetArguments(), Message);
+
+        const char* severityID = Logger::GetSeverityID(record.Level);
+        const char* message = Message.c_str();
+        const char* end = message + Message.size();
+        while (message < end)
+        {
+            const char* lineEnd = (const char*)memchr(message, '\n', (size_t)(end - message));
+            if (!lineEnd)
+                lineEnd = end;
+            const int lineLength = (int)(lineEnd - message);
+
+            if (toTextFile)
+                fprintf(File, "[%s]%s %s: %.*s\n", record.Name, CachedTimeString, severityID, lineLength, message);
+            if (toConsole)
+                printf("%s[%s]%s %s: %.*s\033[0m \n", Logger::GetSeverityConsoleColor(record.Level), record.Name, CachedTimeString, severityID, lineLength, message);
+            if (toEditorConsole)
+            {
+                String line;
+                line.reserve(strlen(record.Name) + lineLength + 32);
+                line.append("[").append(record.Name).append("]").append(CachedTimeString).append(" ").append(severityID).append(": ").append(message, lineLength);
+                Console::Get()->Print(line, record.Level);
+            }
+            message = lineEnd + 1;
+        }
+    }
+
+    void LogBackend::FlushFile()
+    {
+        fflush(stdout);
+        if (File)
+            fflush(File);
+    }
+
+    void LogBackend::WakeUp()
+    {
+        std::lock_guard<std::mutex> lock(SleepMutex);
+        SleepCondition.notify_one();
     }
 
+    void LogBackend::ThreadMain()
+    {
+        Profiler::SetThreadName("Logger");
+        while (Running.load(std::memory_order_acquire))
+        {
+            if (Drain())
+                continue;
+
+            std::unique_lock<std::mutex> lock(SleepMutex);
+            Sleeping.store(true, std::memory_order_relaxed);
+            // The timeout covers a producer that published right after the last Drain but saw Sleeping still false
+            SleepCondition.wait_for(lock, std::chrono::milliseconds(2));
+            Sleeping.store(false, std::memory_order_relaxed);
+        }
+        Drain();
+    }
+
+    /* [Spike] Best effort, the process is going down anyway. Waits a moment for the logging thread to finish its batch,
+     * then writes whatever is in the queue on the crashing thread [Spike] */
+    void LogBackend::OnCrash()
+    {
+        if (!Records)
+            return;
+
+        for (int attempt = 0; attempt < 100; attempt++)
+        {
+            if (ConsumerMutex.try_lock())
+            {
+                Running.store(false, std::memory_order_release);
+                Drain();
+                ConsumerMutex.unlock();
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        FlushFile();
+    }
+
+#ifdef SPK_PLATFORM_WINDOWS
+    static LONG WINAPI OnUnhandledException(EXCEPTION_POINTERS*)
+    {
+        LogBackend::OnCrash();
+        return EXCEPTION_CONTINUE_SEARCH;
+    }
+#endif
+
+    static void OnCrashSignal(int signal)
+    {
+        LogBackend::OnCrash();
+        std::signal(signal, SIG_DFL);
+        std::raise(signal);
+    }
+
+    static void InstallCrashHandlers()
+    {
+#ifdef SPK_PLATFORM_WINDOWS
+        SetUnhandledExceptionFilter(OnUnhandledException);
+#else
+        std::signal(SIGSEGV, OnCrashSignal);
+        std::signal(SIGBUS, OnCrashSignal);
+#endif
+        std::signal(SIGABRT, OnCrashSignal);
+        std::signal(SIGFPE, OnCrashSignal);
+        std::signal(SIGILL, OnCrashSignal);
+    }
+
+    void Logger::Init()
+    {
+        // Anything logged before Init went to the file that is about to become the previous one
+        {
+            std::lock_guard<std::recursive_mutex> lock(LogBackend::ConsumerMutex);
+            LogBackend::CloseFile();
+        }
+
+        if (std::filesystem::exists(Logger::s_CurrentFile))
+        {
+            if (std::filesystem::exists(Logger::s_PreviousFile))
+                std::filesystem::remove(Logger::s_PreviousFile);
+
+            if (rename(Logger::s_CurrentFile, Logger::s_PreviousFile))
+                Logger("Logger").Log(Severity::Debug, "Failed to rename log file %s to %s", Logger::s_CurrentFile, Logger::s_PreviousFile);
+        }
+
+        if (LogBackend::Running)
+            return;
+
+        if (!LogBackend::Records)
+        {
+            LogBackend::Records = new LogRecord[LogBackend::Capacity];
+            for (Uint i = 0; i < LogBackend::Capacity; i++)
+                LogBackend::Records[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+        LogBackend::Running = true;
+        LogBackend::Thread = std::thread(LogBackend::ThreadMain);
+        LogBackend::ThreadID = LogBackend::Thread.get_id();
+        InstallCrashHandlers();
+    }
+
+    void Logger::Shutdown()
+    {
+        Flush();
+        if (LogBackend::Thread.joinable())
+        {
+            LogBackend::Running = false;
+            LogBackend::WakeUp();
+            LogBackend::Thread.join();
+        }
+
+        std::lock_guard<std::recursive_mutex> lock(LogBackend::ConsumerMutex);
+        LogBackend::FlushFile();
+        LogBackend::CloseFile();
+    }
+
+    void Logger::Flush()
+    {
+        if (!LogBackend::Records)
+            return;
+
+        // The logging thread can't wait on itself, and nobody else drains once it is gone
+        if (!LogBackend::Running || std::this_thread::get_id() == LogBackend::ThreadID)
+        {
+            LogBackend::Drain();
+            return;
+        }
+
+        const uint64_t target = LogBackend::EnqueuePosition.load(std::memory_order_acquire);
+        while (LogBackend::WrittenPosition.load(std::memory_order_acquire) < target && LogBackend::Running.load(std::memory_order_acquire))
+        {
+            LogBackend::WakeUp();
+            std::this_thread::yield();
+        }
+    }
+
+    void Logger::SetQueuePolicy(LogQueuePolicy policy) { LogBackend::Policy = policy; }
+    LogQueuePolicy Logger::GetQueuePolicy() { return LogBackend::Policy; }
+    uint64_t Logger::GetDroppedCount() { return LogBackend::Dropped.load(std::memory_order_relaxed); }
+    void Logger::SetFileFormat(LogFileFormat format) { s_FileFormat = format; }
+    LogFileFormat Logger::GetFileFormat() { return s_FileFormat; }
+    void Logger::SetRingFileSize(uint64_t size) { s_RingFileSize = size; }
+    uint64_t Logger::GetRingFileSize() { return s_RingFileSize; }
+
     const char* Logger::GetSeverityConsoleColor(Severity severity)
     {
        /*
@@ -200,73 +649,20 @@ namespace Spike
 
     void Logger::Log(const char* name, Severity severity, const char* format, va_list args)
     {
-        Uint length = vsnprintf(nullptr, 0, format, args) + 1;
-        char* buf = new char[length];
-        vsnprintf(buf, length, format, args);
-
-        std::string message(buf);
-        delete[] buf;
-
-        std::vector<std::string> messages;
-
-        Uint lastIndex = 0;
-        for (Uint i = 0; i < message.length(); i++)
+        if (LogBackend::Running.load(std::memory_order_acquire) && LogBackend::TryEnqueue(name, severity, format, args))
         {
-            if (message[i] == '\n')
-            {
-                messages.push_back(message.substr(lastIndex, i - lastIndex));
-                lastIndex = i + 1;
-            }
-            else if (i == message.length() - 1)
-            {
-                messages.push_back(message.substr(lastIndex));
-            }
-        }
-
-        for (std::string msg : messages)
-        {
-            std::string logMsg = "";
-            std::string systemConsoleMsg = "";
-            std::string editorConsoleMsg = "";
-
-            constexpr Uint timeBufferSize = 16;
-            std::time_t        currentTime = std::time(nullptr);
-            char               timeBuffer[timeBufferSize];
-
-            if (Logger::s_LogToFile)
-                logMsg += "[" + std::string(name) + "]";
-            if (Logger::s_LogToConsole)
-                systemConsoleMsg += std::string(Logger::GetSeverityConsoleColor(severity)) + "[" + std::string(name) + "]";
-            if (Logger::s_LogToEditorConsole)
-                editorConsoleMsg += "[" + std::string(name) + "]";
-
-            if (std::strftime(timeBuffer, timeBufferSize, "[%H:%M:%S]", std::localtime(&currentTime)))
-            {
-                if (Logger::s_LogToFile)
-                    logMsg += timeBuffer;
-                if (Logger::s_LogToConsole)
-                    systemConsoleMsg += timeBuffer;
-                if (Logger::s_LogToEditorConsole)
-                    editorConsoleMsg += timeBuffer;
-            }
-
-            if (Logger::s_LogToFile)
-                logMsg += " " + std::string(Logger::GetSeverityID(severity)) + ": " + msg + "\n";
-            if (Logger::s_LogToConsole)
-                systemConsoleMsg += " " + std::string(Logger::GetSeverityID(severity)) + ": " + msg + +"\033[0m " + "\n";
-            if (Logger::s_LogToEditorConsole)
-                editorConsoleMsg += " " + std::string(Logger::GetSeverityID(severity)) + ": " + msg;
-
-            if (Logger::s_LogToFile)
-                Logger::s_Buffer.push_back(logMsg);
-            if (Logger::s_LogToConsole)
-                printf("%s", systemConsoleMsg.c_str());
-            if (Logger::s_LogToEditorConsole)
-                Console::Get()->Print(editorConsoleMsg, severity);
+            if (severity >= Severity::Error)
+                Flush();
+            return;
         }
 
-        if (Logger::s_LogToFile)
-            if (Logger::s_Buffer.size() > Logger::GetSeverityMaxBufferCount(severity))
-                Flush();
+        // No logging thread (yet, or any more), write it out right here
+        LogRecord record;
+        LogBackend::Fill(record, name, severity, format, args);
+        record.InRing = LogBackend::AppendToRing(record);
+        std::lock_guard<std::recursive_mutex> lock(LogBackend::ConsumerMutex);
+        LogBackend::Write(record);
+        LogBackend::FlushFile();
+        free(record.Overflow);
     }
-}
\ No newline at end of file
+}
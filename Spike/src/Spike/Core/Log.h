@@ -3,6 +3,7 @@
 #pragma once
 #include "Spike/Core/Base.h"
 #include "Spike/Core/Ref.h"
+#include <atomic>
 
 namespace Spike
 {
@@ -16,10 +17,45 @@ namespace Spike
         Critical
     };
 
+    /* [Spike] What a log call does when the queue to the logging thread is full. Errors and criticals always block [Spike] */
+    enum class LogQueuePolicy
+    {
+        Block,
+        Drop // Counted, see Logger::GetDroppedCount
+    };
+
+    /* [Spike] How Logger writes the .spikeLog file. Binary files keep the raw arguments and are read with
+     * Spike-LogDecoder, see BinaryLog [Spike] */
+    enum class LogFileFormat
+    {
+        Text,
+        Binary,
+        Ring // Binary, in a file of fixed size keeping the newest messages, written by the log calls themselves so a crash loses nothing. See LogRingFile
+    };
+
+    /* [Spike] Every Logger with the same name shares one, so a threshold set by name reaches all of them. Created on
+     * first use and never freed [Spike] */
+    struct LogCategory
+    {
+        String Name;
+        std::atomic<Severity> Threshold;
+    };
+
+    /* [Spike] A log call doesn't format anything, it copies the format pointer and the raw arguments into a slot of a
+     * lock free queue (see BinaryLog). A background thread started by Init formats for the consoles and writes the
+     * file. The format has to be a string literal, log runtime text with "%s". Errors and criticals wait until they
+     * are written, so an assert's message is out before the debug break. Before Init and after Shutdown messages are
+     * written on the calling thread.
+     * Go through the SPK_LOG macros rather than calling the members directly: they check the threshold before the
+     * arguments are evaluated, so a disabled call costs one branch [Spike] */
     class Logger
     {
     public:
-        Logger(const char* name);
+        /* [Spike] threshold only applies if this is the first Logger of that name [Spike] */
+        Logger(const char* name, Severity threshold = Severity::Trace);
+
+        bool IsEnabled(Severity severity) const { return severity >= m_Category->Threshold.load(std::memory_order_relaxed); }
+        const char* GetName() const { return m_Category->Name.c_str(); }
 
         void Log(Severity severity, const char* format, ...);
         void LogTrace(const char* format, ...);
@@ -28,7 +64,7 @@ namespace Spike
         void LogWarning(const char* format, ...);
         void LogError(const char* format, ...);
         void LogCritical(const char* format, ...);
-        inline static Logger GetCoreLogger() { return s_CoreLogger; };
+        inline static Logger& GetCoreLogger() { return s_CoreLogger; };
 
         void SetLogToFile(bool value) { s_LogToFile = value; }
         void SetLogToSystemConsole(bool value) { s_LogToConsole = value; }
@@ -36,23 +72,59 @@ namespace Spike
     public:
         static void Init();
         static void Shutdown();
+
+        /* [Spike] Returns once everything logged before the call is written out [Spike] */
         static void Flush();
 
+        static void SetQueuePolicy(LogQueuePolicy policy);
+        static LogQueuePolicy GetQueuePolicy();
+        static uint64_t GetDroppedCount();
+
+        /* [Spike] Messages of the category below threshold are skipped, the category is created if it doesn't exist
+         * yet, so thresholds can be set up before the code that logs runs [Spike] */
+        static void SetThreshold(const char* category, Severity threshold);
+        static Vector<LogCategory*> GetCategories();
+
+        /* [Spike] Takes effect with the next file, Init starts one [Spike] */
+        static void SetFileFormat(LogFileFormat format);
+        static LogFileFormat GetFileFormat();
+        static void SetRingFileSize(uint64_t size);
+        static uint64_t GetRingFileSize();
+
+        static const char* GetSeverityID(Severity severity)
+        {
+            switch (severity)
+            {
+                case Severity::Trace:
+                    return "TRACE";
+                case Severity::Info:
+                    return "INFO";
+                case Severity::Debug:
+                    return "DEBUG";
+                case Severity::Warning:
+                    return "WARNING";
+                case Severity::Error:
+                    return "ERROR";
+                case  Severity::Critical:
+                    return "CRITICAL";
+            }
+            return "Unknown Severity";
+        }
     private:
-        static Uint GetSeverityMaxBufferCount(Severity severity);
-        static const char* GetSeverityID(Severity severity);
         static const char* GetSeverityConsoleColor(Severity severity);
         static void Log(const char* name, Severity severity, const char* format, va_list args);
 
+        friend struct LogBackend;
     private:
-        const char* m_Name;
+        LogCategory* m_Category;
     private:
         static Logger s_CoreLogger;
-        static std::vector<std::string> s_Buffer;
 
-        static bool        s_LogToFile;
-        static bool        s_LogToConsole;
-        static bool        s_LogToEditorConsole;
+        static std::atomic<bool> s_LogToFile;
+        static std::atomic<bool> s_LogToConsole;
+        static std::atomic<bool> s_LogToEditorConsole;
+        static std::atomic<LogFileFormat> s_FileFormat;
+        static std::atomic<uint64_t> s_RingFileSize;
         static const char* s_PreviousFile;
         static const char* s_CurrentFile;
     };
@@ -82,9 +154,36 @@ namespace Spike
     %%                  Prints % character
  * [Spike] */
 
-#define SPK_CORE_LOG_TRACE(...)    ::Spike::Logger::GetCoreLogger().LogTrace(__VA_ARGS__)
-#define SPK_CORE_LOG_DEBUG(...)    ::Spike::Logger::GetCoreLogger().LogDebug(__VA_ARGS__)
-#define SPK_CORE_LOG_INFO(...)     ::Spike::Logger::GetCoreLogger().LogInfo(__VA_ARGS__)
-#define SPK_CORE_LOG_WARN(...)     ::Spike::Logger::GetCoreLogger().LogWarning(__VA_ARGS__)
-#define SPK_CORE_LOG_ERROR(...)    ::Spike::Logger::GetCoreLogger().LogError(__VA_ARGS__)
-#define SPK_CORE_LOG_CRITICAL(...) ::Spike::Logger::GetCoreLogger().LogCritical(__VA_ARGS__)
\ No newline at end of file
+/* [Spike] Calls below SPK_LOG_MIN_SEVERITY (the number of a Severity, 0 is Trace) aren't compiled at all. Release
+ * builds strip Trace by default, define it yourself to strip more [Spike] */
+#ifndef SPK_LOG_MIN_SEVERITY
+    #ifdef SPK_RELEASE
+        #define SPK_LOG_MIN_SEVERITY 1
+    #else
+        #define SPK_LOG_MIN_SEVERITY 0
+    #endif
+#endif
+
+#define SPK_LOG(logger, severity, ...)                                            \
+    do                                                                            \
+    {                                                                             \
+        if constexpr ((int)(severity) >= SPK_LOG_MIN_SEVERITY)                    \
+        {                                                                         \
+            if ((logger).IsEnabled(severity))                                     \
+                (logger).Log(severity, __VA_ARGS__);                              \
+        }                                                                         \
+    } while (0)
+
+#define SPK_LOG_TRACE(logger, ...)    SPK_LOG(logger, ::Spike::Severity::Trace, __VA_ARGS__)
+#define SPK_LOG_DEBUG(logger, ...)    SPK_LOG(logger, ::Spike::Severity::Debug, __VA_ARGS__)
+#define SPK_LOG_INFO(logger, ...)     SPK_LOG(logger, ::Spike::Severity::Info, __VA_ARGS__)
+#define SPK_LOG_WARN(logger, ...)     SPK_LOG(logger, ::Spike::Severity::Warning, __VA_ARGS__)
+#define SPK_LOG_ERROR(logger, ...)    SPK_LOG(logger, ::Spike::Severity::Error, __VA_ARGS__)
+#define SPK_LOG_CRITICAL(logger, ...) SPK_LOG(logger, ::Spike::Severity::Critical, __VA_ARGS__)
+
+#define SPK_CORE_LOG_TRACE(...)    SPK_LOG_TRACE(::Spike::Logger::GetCoreLogger(), __VA_ARGS__)
+#define SPK_CORE_LOG_DEBUG(...)    SPK_LOG_DEBUG(::Spike::Logger::GetCoreLogger(), __VA_ARGS__)
+#define SPK_CORE_LOG_INFO(...)     SPK_LOG_INFO(::Spike::Logger::GetCoreLogger(), __VA_ARGS__)
+#define SPK_CORE_LOG_WARN(...)     SPK_LOG_WARN(::Spike::Logger::GetCoreLogger(), __VA_ARGS__)
+#define SPK_CORE_LOG_ERROR(...)    SPK_LOG_ERROR(::Spike::Logger::GetCoreLogger(), __VA_ARGS__)
+#define SPK_CORE_LOG_CRITICAL(...) SPK_LOG_CRITICAL(::Spike::Logger::GetCoreLogger(), __VA_ARGS__)
\ No newline at end of file
@@ -0,0 +1,215 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "LogRingFile.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <tuple>
+
+namespace Spike
+{
+    struct RingFileHeader
+    {
+        char Magic[6];
+        uint16_t Version;
+        uint64_t Capacity; // Bytes of records after the header
+        uint64_t Reserved; // Bytes ever handed out to writers, wasted lap ends included. Used as a std::atomic
+        byte Padding[40];
+    };
+    static_assert(sizeof(RingFileHeader) == 64, "The ring file header has to keep the records 8 byte aligned!");
+
+    /* [Spike] Followed by the logger name, the format (both with their terminator) and the encoded arguments [Spike] */
+    struct RingRecord
+    {
+        static constexpr uint32_t Complete = 0x524B5053; // "SPKR"
+
+        uint32_t State;       // Complete once everything else is written, stored last
+        uint32_t Size;        // Of the whole record, a multiple of 8
+        uint64_t Position;    // Where it was reserved, the offset in the ring is Position % Capacity
+        int64_t Timestamp;    // Nanoseconds since the epoch
+        Uint ThreadID;
+        uint8_t Level;
+        uint8_t Padding;
+        uint16_t NameSize;
+        uint16_t FormatSize;
+        uint16_t Padding2;
+        Uint ArgumentsSize;
+    };
+    static_assert(sizeof(RingRecord) % 8 == 0, "Ring records have to stay 8 byte aligned!");
+    static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t) && std::atomic<uint64_t>::is_always_lock_free, "The reserve counter lives in the file!");
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free, "Record states live in the file!");
+
+    static uint64_t AlignRecord(uint64_t size)
+    {
+        return (size + 7) & ~(uint64_t)7;
+    }
+
+    bool LogRingFile::Open(const String& filepath, uint64_t size)
+    {
+        Close();
+        const uint64_t capacity = (std::max(size, MinimumSize) - sizeof(RingFileHeader)) & ~(uint64_t)7;
+        const uint64_t fileSize = sizeof(RingFileHeader) + capacity;
+
+        // Only a ring of the same capacity can be continued, the records of another one could pass for valid ones
+        bool resume = false;
+        {
+            MappedFile existing(filepath, FileAccessHint::Random);
+            if (existing && existing.GetSize() == fileSize && IsRingFile(existing))
+            {
+                RingFileHeader header;
+                memcpy(&header, existing.GetData(), sizeof(header));
+                resume = header.Version == Version && header.Capacity == capacity;
+            }
+        }
+        if (!resume)
+        {
+            std::error_code error;
+            std::filesystem::remove(filepath, error);
+        }
+
+        if (!m_File.Create(filepath, fileSize))
+            return false;
+
+        RingFileHeader* header = (RingFileHeader*)m_File.GetWritableData();
+        if (!resume)
+        {
+            memcpy(header->Magic, Magic, sizeof(Magic));
+            header->Version = Version;
+            header->Capacity = capacity;
+            header->Reserved = 0;
+        }
+        m_Reserved = reinterpret_cast<std::atomic<uint64_t>*>(&header->Reserved);
+        m_Records = m_File.GetWritableData() + sizeof(RingFileHeader);
+        m_Capacity = capacity;
+        return true;
+    }
+
+    void LogRingFile::Close()
+    {
+        m_File.Close();
+        m_Reserved = nullptr;
+        m_Records = nullptr;
+        m_Capacity = 0;
+    }
+
+    bool LogRingFile::Append(const BinaryLogMessage& message)
+    {
+        const size_t nameSize = strlen(message.Name) + 1;
+        const size_t formatSize = strlen(message.Format) + 1;
+        if (nameSize > UINT16_MAX || formatSize > UINT16_MAX)
+            return false;
+
+        const uint64_t limit = m_Capacity / 8;
+        uint64_t argumentsSize = message.Arguments.Size;
+        if (AlignRecord(sizeof(RingRecord) + nameSize + formatSize + argumentsSize) > limit)
+            argumentsSize = 0;
+        const uint64_t size = AlignRecord(sizeof(RingRecord) + nameSize + formatSize + argumentsSize);
+        if (size > limit)
+            return false;
+
+        // A reservation running over the end is given up, the next one starts in the next lap
+        uint64_t position = 0;
+        uint64_t offset = 0;
+        do
+        {
+            position = m_Reserved->fetch_add(size, std::memory_order_relaxed);
+            offset = position % m_Capacity;
+        } while (offset + size > m_Capacity);
+
+        RingRecord record = {};
+        record.Size = (uint32_t)size;
+        record.Position = position;
+        record.Timestamp = message.Timestamp;
+        record.ThreadID = message.ThreadID;
+        record.Level = (uint8_t)message.Level;
+        record.NameSize = (uint16_t)nameSize;
+        record.FormatSize = (uint16_t)formatSize;
+        record.ArgumentsSize = (Uint)argumentsSize;
+
+        // The State of whatever was here before is cleared by the first copy
+        byte* destination = m_Records + offset;
+        memcpy(destination, &record, sizeof(record));
+        byte* cursor = destination + sizeof(record);
+        memcpy(cursor, message.Name, nameSize);
+        cursor += nameSize;
+        memcpy(cursor, message.Format, formatSize);
+        cursor += formatSize;
+        if (argumentsSize)
+            memcpy(cursor, message.Arguments.Data, (size_t)argumentsSize);
+
+        reinterpret_cast<std::atomic<uint32_t>*>(destination)->store(RingRecord::Complete, std::memory_order_release);
+        return true;
+    }
+
+    bool LogRingFile::IsRingFile(BufferView data)
+    {
+        return data.Size >= sizeof(RingFileHeader) && memcmp(data.Data, Magic, sizeof(Magic)) == 0;
+    }
+
+    /* [Spike] Records reserved before begin may be partly overwritten by now, whatever claims a position that doesn't
+     * match where it sits is a leftover of an older lap or the middle of some other record [Spike] */
+    static bool IsIntact(const RingRecord& record, const byte* data, uint64_t offset, uint64_t capacity, uint64_t begin, uint64_t end)
+    {
+        if (record.State != RingRecord::Complete || record.Size < sizeof(RingRecord) || record.Size % 8 != 0 || offset + record.Size > capacity)
+            return false;
+        if (record.Position < begin || record.Position + record.Size > end || record.Position % capacity != offset)
+            return false;
+        if (!record.NameSize || !record.FormatSize || sizeof(RingRecord) + (uint64_t)record.NameSize + record.FormatSize + record.ArgumentsSize > record.Size)
+            return false;
+
+        const char* strings = (const char*)data + sizeof(RingRecord);
+        return strings[record.NameSize - 1] == '\0' && strings[record.NameSize + record.FormatSize - 1] == '\0';
+    }
+
+    bool LogRingFile::Decode(BufferView data, const std::function<void(const BinaryLogMessage&)>& onMessage)
+    {
+        if (!IsRingFile(data))
+            return false;
+
+        RingFileHeader header;
+        memcpy(&header, data.Data, sizeof(header));
+        if (header.Version != Version || header.Capacity == 0 || header.Capacity % 8 != 0 || header.Capacity > data.Size - sizeof(RingFileHeader))
+            return false;
+
+        const byte* records = data.Data + sizeof(RingFileHeader);
+        const uint64_t capacity = header.Capacity;
+        const uint64_t end = header.Reserved;
+        const uint64_t begin = end > capacity ? end - capacity : 0;
+
+        // Every record starts 8 byte aligned, so stepping over the garbage between them finds all of them
+        Vector<std::tuple<int64_t, uint64_t, uint64_t>> found; // Timestamp, position and offset
+        for (uint64_t offset = 0; offset + sizeof(RingRecord) <= capacity;)
+        {
+            RingRecord record;
+            memcpy(&record, records + offset, sizeof(record));
+            if (IsIntact(record, records + offset, offset, capacity, begin, end))
+            {
+                found.emplace_back(record.Timestamp, record.Position, offset);
+                offset += record.Size;
+            }
+            else
+                offset += 8;
+        }
+        // Ring order is the order the records were appended, messages logged before the ring was open are appended
+        // late by the logging thread, the timestamps put them back where they belong
+        std::sort(found.begin(), found.end());
+
+        for (const auto& [timestamp, position, offset] : found)
+        {
+            RingRecord record;
+            memcpy(&record, records + offset, sizeof(record));
+            const char* strings = (const char*)records + offset + sizeof(RingRecord);
+
+            BinaryLogMessage message;
+            message.Name = strings;
+            message.Format = strings + record.NameSize;
+            message.Level = (Severity)std::min<uint8_t>(record.Level, (uint8_t)Severity::Critical);
+            message.ThreadID = record.ThreadID;
+            message.Timestamp = record.Timestamp;
+            message.Arguments = BufferView((const byte*)strings + record.NameSize + record.FormatSize, record.ArgumentsSize);
+            onMessage(message);
+        }
+        return true;
+    }
+}
@@ -0,0 +1,57 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Core/BinaryLog.h"
+#include "Spike/Core/MappedFile.h"
+#include <atomic>
+
+namespace Spike
+{
+    /* [Spike] A log file of fixed size that keeps the newest messages. The file is mapped shared, so Append is a few
+     * copies into memory, no write calls, no locks. The OS writes the pages back whenever it likes, also after the
+     * process died, which is the point: a crash keeps everything up to the message being appended when it happened.
+     * A machine losing power keeps whatever pages made it to the disk, in no particular order.
+     *
+     * Layout, native endianness: a header with the capacity and how many bytes were ever reserved, then the records.
+     * Writers reserve space with one atomic add on that counter, a record never wraps around the end, the rest of the
+     * lap is skipped instead. Records carry the position they were reserved at and are only marked complete once
+     * fully written, so Decode finds the valid ones with a scan and puts them back in order. A writer stalled for a
+     * whole lap of the ring could still garble a newer record, MinimumSize keeps that out of reach. Unlike the binary
+     * log every record brings its own logger name and format, older string definitions would get overwritten [Spike] */
+    class LogRingFile
+    {
+    public:
+        static constexpr char Magic[6] = { 'S', 'P', 'K', 'R', 'N', 'G' };
+        static constexpr uint16_t Version = 1;
+        static constexpr uint64_t MinimumSize = 1024 * 1024;
+
+        LogRingFile() = default;
+        ~LogRingFile() = default;
+
+        LogRingFile(const LogRingFile&) = delete;
+        LogRingFile& operator=(const LogRingFile&) = delete;
+
+        /* [Spike] Picks up where an existing ring of the same size left off, anything else at filepath is replaced by
+         * an empty ring. Sizes below MinimumSize are raised to it [Spike] */
+        bool Open(const String& filepath, uint64_t size);
+        void Close();
+
+        /* [Spike] Safe from any number of threads. Returns false if the message takes more than an eighth of the ring
+         * even without its arguments, too big ones are stored without them [Spike] */
+        bool Append(const BinaryLogMessage& message);
+
+        bool IsOpen() const { return m_Records != nullptr; }
+        uint64_t GetCapacity() const { return m_Capacity; }
+
+        static bool IsRingFile(BufferView data);
+
+        /* [Spike] Calls onMessage for every complete message still in the ring, in the order they were logged. The
+         * pointers in the message point into data. Returns false if data isn't a ring file [Spike] */
+        static bool Decode(BufferView data, const std::function<void(const BinaryLogMessage&)>& onMessage);
+    private:
+        MappedFile m_File;
+        std::atomic<uint64_t>* m_Reserved = nullptr;
+        byte* m_Records = nullptr;
+        uint64_t m_Capacity = 0;
+    };
+}
@@ -0,0 +1,246 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "MappedFile.h"
+
+#ifndef SPK_PLATFORM_WINDOWS
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Spike
+{
+    MappedFile::MappedFile(const String& filepath, FileAccessHint hint)
+    {
+        Open(filepath, hint);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        :m_Data(other.m_Data), m_Size(other.m_Size), m_Open(other.m_Open), m_Writable(other.m_Writable)
+    {
+        other.m_Data = nullptr;
+        other.m_Size = 0;
+        other.m_Open = false;
+        other.m_Writable = false;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            m_Data = other.m_Data;
+            m_Size = other.m_Size;
+            m_Open = other.m_Open;
+            m_Writable = other.m_Writable;
+            other.m_Data = nullptr;
+            other.m_Size = 0;
+            other.m_Open = false;
+            other.m_Writable = false;
+        }
+        return *this;
+    }
+
+#ifdef SPK_PLATFORM_WINDOWS
+    bool MappedFile::Open(const String& filepath, FileAccessHint hint)
+    {
+        Close();
+        DWORD flags = FILE_ATTRIBUTE_NORMAL;
+        if (hint == FileAccessHint::Sequential)
+            flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+        else if (hint == FileAccessHint::Random)
+            flags |= FILE_FLAG_RANDOM_ACCESS;
+
+        HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, flags, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size = {};
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        // Windows can't map an empty file
+        if (size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            m_Open = true;
+            return true;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+            return false;
+
+        // The view keeps the mapping alive, the handles aren't needed past this point
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!data)
+            return false;
+
+        m_Data = (byte*)data;
+        m_Size = (uint64_t)size.QuadPart;
+        m_Open = true;
+        return true;
+    }
+
+    bool MappedFile::Create(const String& filepath, uint64_t size)
+    {
+        Close();
+        if (size == 0)
+            return false;
+
+        HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER end = {};
+        end.QuadPart = (LONGLONG)size;
+        if (!SetFilePointerEx(file, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, (DWORD)(size >> 32), (DWORD)(size & 0xFFFFFFFF), nullptr);
+        CloseHandle(file);
+        if (!mapping)
+            return false;
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, (SIZE_T)size);
+        CloseHandle(mapping);
+        if (!data)
+            return false;
+
+        m_Data = (byte*)data;
+        m_Size = size;
+        m_Open = true;
+        m_Writable = true;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+            UnmapViewOfFile(m_Data);
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Open = false;
+        m_Writable = false;
+    }
+
+    void MappedFile::Advise(FileAccessHint hint, uint64_t offset, uint64_t size)
+    {
+        // Windows takes the access pattern when the file is opened, there is nothing to change afterwards
+        (void)hint; (void)offset; (void)size;
+    }
+#else
+    static int ToMadvise(FileAccessHint hint)
+    {
+        switch (hint)
+        {
+            case FileAccessHint::Normal:     return MADV_NORMAL;
+            case FileAccessHint::Sequential: return MADV_SEQUENTIAL;
+            case FileAccessHint::Random:     return MADV_RANDOM;
+            case FileAccessHint::WillNeed:   return MADV_WILLNEED;
+        }
+        return MADV_NORMAL;
+    }
+
+    bool MappedFile::Open(const String& filepath, FileAccessHint hint)
+    {
+        Close();
+        int file = open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(file, &info) != 0)
+        {
+            close(file);
+            return false;
+        }
+
+        // mmap refuses a length of zero
+        if (info.st_size == 0)
+        {
+            close(file);
+            m_Open = true;
+            return true;
+        }
+
+        // The mapping keeps the file alive, the descriptor isn't needed past this point
+        void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if (data == MAP_FAILED)
+            return false;
+
+        m_Data = (byte*)data;
+        m_Size = (uint64_t)info.st_size;
+        m_Open = true;
+        Advise(hint);
+        return true;
+    }
+
+    bool MappedFile::Create(const String& filepath, uint64_t size)
+    {
+        Close();
+        if (size == 0)
+            return false;
+
+        int file = open(filepath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (file < 0)
+            return false;
+
+        // Grown files are sparse, the blocks are only allocated once the pages are written
+        if (ftruncate(file, (off_t)size) != 0)
+        {
+            close(file);
+            return false;
+        }
+
+        void* data = mmap(nullptr, (size_t)size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        close(file);
+        if (data == MAP_FAILED)
+            return false;
+
+        m_Data = (byte*)data;
+        m_Size = size;
+        m_Open = true;
+        m_Writable = true;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+            munmap(m_Data, (size_t)m_Size);
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Open = false;
+        m_Writable = false;
+    }
+
+    void MappedFile::Advise(FileAccessHint hint, uint64_t offset, uint64_t size)
+    {
+        if (!m_Data || offset >= m_Size)
+            return;
+
+        // madvise wants a page aligned start, round the offset down and grow the range by what we skipped
+        static const uint64_t pageSize = (uint64_t)sysconf(_SC_PAGESIZE);
+        const uint64_t alignedOffset = offset & ~(pageSize - 1);
+        const uint64_t end = (size == 0 || offset + size > m_Size) ? m_Size : offset + size;
+        madvise(m_Data + alignedOffset, (size_t)(end - alignedOffset), ToMadvise(hint));
+    }
+#endif
+}
@@ -0,0 +1,61 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Core/Buffer.h"
+#include <string_view>
+
+namespace Spike
+{
+    enum class FileAccessHint
+    {
+        Normal = 0,
+        Sequential, // Read front to back once, the OS reads ahead aggressively and drops pages behind us
+        Random,     // Jumping around, no read ahead
+        WillNeed    // Start paging the whole range in now
+    };
+
+    /* [Spike] Read only view of a whole file mapped into memory. The bytes are paged in on first touch, nothing is
+     * copied until somebody copies it. Move only, the mapping goes away with the object, so never keep a view
+     * longer than the MappedFile. Don't hold on to mappings of files that get rewritten while we run (assemblies,
+     * scripts), the OS either refuses the write or hands us a truncated file.
+     * Create is the one writable flavour, the mapping is shared with the file, so what is written lands in the file
+     * without any write calls and survives the process dying, the OS writes the pages back on its own [Spike] */
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const String& filepath, FileAccessHint hint = FileAccessHint::Sequential);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /* [Spike] Returns false if the file can't be opened or mapped. Empty files open fine with a null view [Spike] */
+        bool Open(const String& filepath, FileAccessHint hint = FileAccessHint::Sequential);
+
+        /* [Spike] Maps filepath for writing, creating it if needed. An existing file keeps its contents and is cut or
+         * grown to size, new bytes read as zeros [Spike] */
+        bool Create(const String& filepath, uint64_t size);
+        void Close();
+
+        /* [Spike] Changes the paging hint for a range of the mapping, size 0 means up to the end [Spike] */
+        void Advise(FileAccessHint hint, uint64_t offset = 0, uint64_t size = 0);
+
+        bool IsOpen() const { return m_Open; }
+        const byte* GetData() const { return m_Data; }
+        byte* GetWritableData() const { return m_Writable ? m_Data : nullptr; }
+        uint64_t GetSize() const { return m_Size; }
+        BufferView GetView() const { return BufferView(m_Data, m_Size); }
+        std::string_view GetString() const { return std::string_view((const char*)m_Data, (size_t)m_Size); }
+
+        operator bool() const { return m_Open; }
+        operator BufferView() const { return GetView(); }
+    private:
+        byte* m_Data = nullptr;
+        uint64_t m_Size = 0;
+        bool m_Open = false;
+        bool m_Writable = false;
+    };
+}
@@ -0,0 +1,219 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "MemoryTracker.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <new>
+
+namespace Spike
+{
+    static thread_local MemoryTag s_CurrentTag = MemoryTag::Untagged;
+
+    MemoryTag MemoryTracker::GetCurrentTag() { return s_CurrentTag; }
+    void MemoryTracker::SetCurrentTag(MemoryTag tag) { s_CurrentTag = tag; }
+
+    const char* MemoryTracker::GetTagName(MemoryTag tag)
+    {
+        switch (tag)
+        {
+            case MemoryTag::Untagged:   return "Untagged";
+            case MemoryTag::Renderer:   return "Renderer";
+            case MemoryTag::Renderer2D: return "Renderer2D";
+            case MemoryTag::Vault:      return "Vault";
+            case MemoryTag::Scripting:  return "Scripting";
+            case MemoryTag::Physics2D:  return "Physics2D";
+            case MemoryTag::Scene:      return "Scene";
+            case MemoryTag::Editor:     return "Editor";
+            case MemoryTag::Count:      break;
+        }
+        return "Unknown";
+    }
+
+#ifdef SPK_TRACK_MEMORY
+    /* [Spike] One cache line aligned set per thread, so counting an allocation never contends with another thread.
+     * Frees are counted by the freeing thread, only the sums over all threads mean anything [Spike] */
+    struct alignas(64) ThreadMemoryCounters
+    {
+        struct Counters
+        {
+            std::atomic<int64_t> Allocations = 0;
+            std::atomic<int64_t> Frees = 0;
+            std::atomic<int64_t> BytesAllocated = 0;
+            std::atomic<int64_t> BytesFreed = 0;
+        };
+        Counters Tags[(size_t)MemoryTag::Count];
+    };
+
+    /* [Spike] In front of every tracked allocation. Keeps new's default alignment for the block that follows [Spike] */
+    struct AllocationHeader
+    {
+        size_t Size;
+        uint32_t Offset; // From the start of the malloc'd block to the returned pointer
+        MemoryTag Tag;
+    };
+    static const size_t HeaderSize = 16;
+    static_assert(sizeof(AllocationHeader) <= HeaderSize, "AllocationHeader must fit in front of the allocation!");
+
+    // Threads past the limit share the last set, the counters are atomic so that stays correct
+    static const Uint MaxTrackedThreads = 64;
+    static ThreadMemoryCounters s_ThreadCounters[MaxTrackedThreads];
+    static std::atomic<Uint> s_NextThreadSlot = 0;
+    static thread_local ThreadMemoryCounters* s_Counters = nullptr;
+
+    static ThreadMemoryCounters& GetThreadCounters()
+    {
+        if (!s_Counters)
+            s_Counters = &s_ThreadCounters[std::min(s_NextThreadSlot.fetch_add(1, std::memory_order_relaxed), MaxTrackedThreads - 1)];
+        return *s_Counters;
+    }
+
+    static void* TrackedAllocate(size_t size, size_t alignment)
+    {
+        alignment = std::max(alignment, HeaderSize);
+        byte* block = (byte*)malloc(size + HeaderSize + (alignment > HeaderSize ? alignment : 0));
+        if (!block)
+            return nullptr;
+
+        byte* memory = (byte*)(((uintptr_t)block + HeaderSize + alignment - 1) & ~(uintptr_t)(alignment - 1));
+        AllocationHeader* header = (AllocationHeader*)(memory - HeaderSize);
+        header->Size = size;
+        header->Offset = (uint32_t)(memory - block);
+        header->Tag = s_CurrentTag;
+
+        auto& counters = GetThreadCounters().Tags[(size_t)header->Tag];
+        counters.Allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.BytesAllocated.fetch_add((int64_t)size, std::memory_order_relaxed);
+        return memory;
+    }
+
+    static void TrackedFree(void* memory)
+    {
+        if (!memory)
+            return;
+
+        AllocationHeader* header = (AllocationHeader*)((byte*)memory - HeaderSize);
+        auto& counters = GetThreadCounters().Tags[(size_t)header->Tag];
+        counters.Frees.fetch_add(1, std::memory_order_relaxed);
+        counters.BytesFreed.fetch_add((int64_t)header->Size, std::memory_order_relaxed);
+        free((byte*)memory - header->Offset);
+    }
+
+    static MemoryStats s_FrameStats;
+    static int64_t s_PreviousAllocations[(size_t)MemoryTag::Count] = {};
+    static int64_t s_PreviousBytes[(size_t)MemoryTag::Count] = {};
+
+    MemoryStats MemoryTracker::GetStats()
+    {
+        MemoryStats stats = s_FrameStats;
+        for (auto& tag : stats)
+        {
+            tag.LiveBytes = 0;
+            tag.LiveAllocations = 0;
+            tag.TotalAllocations = 0;
+        }
+
+        const Uint threadCount = std::min(s_NextThreadSlot.load(std::memory_order_relaxed), MaxTrackedThreads);
+        for (Uint thread = 0; thread < threadCount; thread++)
+        {
+            for (size_t tag = 0; tag < stats.size(); tag++)
+            {
+                const auto& counters = s_ThreadCounters[thread].Tags[tag];
+                const int64_t allocations = counters.Allocations.load(std::memory_order_relaxed);
+                stats[tag].LiveBytes += counters.BytesAllocated.load(std::memory_order_relaxed) - counters.BytesFreed.load(std::memory_order_relaxed);
+                stats[tag].LiveAllocations += allocations - counters.Frees.load(std::memory_order_relaxed);
+                stats[tag].TotalAllocations += allocations;
+            }
+        }
+        return stats;
+    }
+
+    void MemoryTracker::EndFrame()
+    {
+        const MemoryStats current = GetStats();
+        const Uint threadCount = std::min(s_NextThreadSlot.load(std::memory_order_relaxed), MaxTrackedThreads);
+        for (size_t tag = 0; tag < current.size(); tag++)
+        {
+            int64_t bytes = 0;
+            for (Uint thread = 0; thread < threadCount; thread++)
+                bytes += s_ThreadCounters[thread].Tags[tag].BytesAllocated.load(std::memory_order_relaxed);
+
+            MemoryTagStats& stats = s_FrameStats[tag];
+            stats.AllocationsLastFrame = current[tag].TotalAllocations - s_PreviousAllocations[tag];
+            stats.BytesLastFrame = bytes - s_PreviousBytes[tag];
+            stats.PeakLiveBytes = std::max(stats.PeakLiveBytes, current[tag].LiveBytes);
+            s_PreviousAllocations[tag] = current[tag].TotalAllocations;
+            s_PreviousBytes[tag] = bytes;
+        }
+    }
+#else
+    MemoryStats MemoryTracker::GetStats() { return MemoryStats(); }
+    void MemoryTracker::EndFrame() {}
+#endif
+
+    bool MemoryTracker::DumpToFile(const String& filepath)
+    {
+        std::filesystem::path path{ filepath };
+        if (path.has_parent_path())
+            std::filesystem::create_directories(path.parent_path());
+
+        FILE* file = fopen(filepath.c_str(), "w");
+        if (!file)
+            return false;
+
+        char timeBuffer[32] = "";
+        std::time_t currentTime = std::time(nullptr);
+        std::strftime(timeBuffer, sizeof(timeBuffer), "%Y-%m-%d %H:%M:%S", std::localtime(&currentTime));
+        fprintf(file, "Spike memory report, %s\n", timeBuffer);
+        if (!IsEnabled())
+            fprintf(file, "Memory tracking is compiled out, configure with SPK_TRACK_MEMORY=ON to record allocations\n");
+
+        fprintf(file, "%-12s %14s %12s %14s %14s %14s %14s\n", "Tag", "Live Bytes", "Live Allocs", "Peak Bytes", "Allocs/Frame", "Bytes/Frame", "Total Allocs");
+        const MemoryStats stats = GetStats();
+        for (size_t tag = 0; tag < stats.size(); tag++)
+        {
+            const MemoryTagStats& s = stats[tag];
+            fprintf(file, "%-12s %14lld %12lld %14lld %14lld %14lld %14lld\n", GetTagName((MemoryTag)tag), (long long)s.LiveBytes,
+                (long long)s.LiveAllocations, (long long)s.PeakLiveBytes, (long long)s.AllocationsLastFrame, (long long)s.BytesLastFrame,
+                (long long)s.TotalAllocations);
+        }
+        fclose(file);
+        return true;
+    }
+}
+
+#ifdef SPK_TRACK_MEMORY
+    /* [Spike] Replacing these in the same translation unit as MemoryTracker makes sure the linker keeps them [Spike] */
+    static void* TrackedNew(size_t size, size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        void* memory = Spike::TrackedAllocate(size ? size : 1, alignment);
+        if (!memory)
+            throw std::bad_alloc();
+        return memory;
+    }
+
+    void* operator new(size_t size) { return TrackedNew(size); }
+    void* operator new[](size_t size) { return TrackedNew(size); }
+    void* operator new(size_t size, std::align_val_t alignment) { return TrackedNew(size, (size_t)alignment); }
+    void* operator new[](size_t size, std::align_val_t alignment) { return TrackedNew(size, (size_t)alignment); }
+    void* operator new(size_t size, const std::nothrow_t&) noexcept { return Spike::TrackedAllocate(size ? size : 1, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+    void* operator new[](size_t size, const std::nothrow_t&) noexcept { return Spike::TrackedAllocate(size ? size : 1, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+    void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return Spike::TrackedAllocate(size ? size : 1, (size_t)alignment); }
+    void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return Spike::TrackedAllocate(size ? size : 1, (size_t)alignment); }
+
+    void operator delete(void* memory) noexcept { Spike::TrackedFree(memory); }
+    void operator delete[](void* memory) noexcept { Spike::TrackedFree(memory); }
+    void operator delete(void* memory, size_t) noexcept { Spike::TrackedFree(memory); }
+    void operator delete[](void* memory, size_t) noexcept { Spike::TrackedFree(memory); }
+    void operator delete(void* memory, std::align_val_t) noexcept { Spike::TrackedFree(memory); }
+    void operator delete[](void* memory, std::align_val_t) noexcept { Spike::TrackedFree(memory); }
+    void operator delete(void* memory, size_t, std::align_val_t) noexcept { Spike::TrackedFree(memory); }
+    void operator delete[](void* memory, size_t, std::align_val_t) noexcept { Spike::TrackedFree(memory); }
+    void operator delete(void* memory, const std::nothrow_t&) noexcept { Spike::TrackedFree(memory); }
+    void operator delete[](void* memory, const std::nothrow_t&) noexcept { Spike::TrackedFree(memory); }
+    void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept { Spike::TrackedFree(memory); }
+    void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept { Spike::TrackedFree(memory); }
+#endif
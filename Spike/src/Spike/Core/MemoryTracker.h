@@ -0,0 +1,83 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Core/Base.h"
+#include <array>
+
+namespace Spike
+{
+    enum class MemoryTag : uint8_t
+    {
+        Untagged = 0,
+        Renderer,
+        Renderer2D,
+        Vault,
+        Scripting,
+        Physics2D,
+        Scene,
+        Editor,
+        Count
+    };
+
+    struct MemoryTagStats
+    {
+        int64_t LiveBytes = 0;
+        int64_t LiveAllocations = 0;
+        int64_t PeakLiveBytes = 0;        // Highest LiveBytes seen at the end of a frame
+        int64_t AllocationsLastFrame = 0;
+        int64_t BytesLastFrame = 0;       // Allocated during the last frame, freed or not
+        int64_t TotalAllocations = 0;
+    };
+
+    using MemoryStats = std::array<MemoryTagStats, (size_t)MemoryTag::Count>;
+
+    /* [Spike] Opt in with SPK_TRACK_MEMORY (CMake option). The global operator new and delete then put a small header in
+     * front of every allocation recording its size and the tag of the allocating thread, and count it in per thread
+     * counters that are only summed up when the stats are read. Without it nothing is hooked and every stat stays zero [Spike] */
+    class MemoryTracker
+    {
+    public:
+        static constexpr bool IsEnabled()
+        {
+#ifdef SPK_TRACK_MEMORY
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        static MemoryTag GetCurrentTag();
+        static void SetCurrentTag(MemoryTag tag);
+        static const char* GetTagName(MemoryTag tag);
+
+        /* [Spike] Takes the per frame snapshot, Application::Run calls it once per frame [Spike] */
+        static void EndFrame();
+        static MemoryStats GetStats();
+
+        /* [Spike] Writes the stats of every tag as a table, returns false if the file can't be opened [Spike] */
+        static bool DumpToFile(const String& filepath);
+    };
+
+    /* [Spike] Everything this thread allocates until the scope ends is counted under tag. Jobs inherit the tag of the
+     * thread that queued them [Spike] */
+    class MemoryTagScope
+    {
+    public:
+        MemoryTagScope(MemoryTag tag)
+            :m_Previous(MemoryTracker::GetCurrentTag()) { MemoryTracker::SetCurrentTag(tag); }
+        ~MemoryTagScope() { MemoryTracker::SetCurrentTag(m_Previous); }
+
+        MemoryTagScope(const MemoryTagScope&) = delete;
+        MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+    private:
+        MemoryTag m_Previous;
+    };
+}
+
+#ifdef SPK_TRACK_MEMORY
+    #define SPK_MEMORY_TAG_CONCAT_INNER(a, b) a##b
+    #define SPK_MEMORY_TAG_CONCAT(a, b) SPK_MEMORY_TAG_CONCAT_INNER(a, b)
+    #define SPK_MEMORY_TAG(tag) ::Spike::MemoryTagScope SPK_MEMORY_TAG_CONCAT(memoryTagScope, __LINE__)(::Spike::MemoryTag::tag)
+#else
+    #define SPK_MEMORY_TAG(tag)
+#endif
@@ -0,0 +1,102 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "ObjectPool.h"
+
+namespace Spike
+{
+    /* [Spike] Sits at the start of every slab, the slots follow on the next cache line [Spike] */
+    struct ObjectPool::Slab
+    {
+        ObjectPool* Pool;
+    };
+
+    static_assert(sizeof(ObjectPool*) <= ObjectPool::CacheLineSize, "Slab header must fit into one cache line!");
+
+    static std::mutex s_RegistryMutex;
+    static Vector<ObjectPool*>& GetRegistry()
+    {
+        static Vector<ObjectPool*>* registry = new Vector<ObjectPool*>();
+        return *registry;
+    }
+
+    ObjectPool::ObjectPool(const char* typeName, size_t objectSize)
+        :m_TypeName(typeName)
+    {
+        m_SlotSize = (std::max(objectSize, sizeof(void*)) + CacheLineSize - 1) & ~(CacheLineSize - 1);
+        m_SlotsPerSlab = (Uint)((SlabSize - CacheLineSize) / m_SlotSize);
+    }
+
+    ObjectPool* ObjectPool::Register(const char* typeName, size_t objectSize)
+    {
+        ObjectPool* pool = new ObjectPool(typeName, objectSize);
+        std::lock_guard<std::mutex> lock(s_RegistryMutex);
+        GetRegistry().push_back(pool);
+        return pool;
+    }
+
+    void ObjectPool::AddSlab()
+    {
+        byte* memory = (byte*)::operator new(SlabSize, std::align_val_t(SlabSize));
+        new (memory) Slab{ this };
+
+        // Linked back to front, so the first allocations come out in address order
+        byte* slots = memory + CacheLineSize;
+        for (Uint i = m_SlotsPerSlab; i-- > 0;)
+        {
+            void* slot = slots + i * m_SlotSize;
+            *(void**)slot = m_FreeList;
+            m_FreeList = slot;
+        }
+        m_SlabCount++;
+    }
+
+    void* ObjectPool::Allocate()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if (!m_FreeList)
+            AddSlab();
+
+        void* slot = m_FreeList;
+        m_FreeList = *(void**)slot;
+        m_LiveObjects++;
+        m_HighWaterMark = std::max(m_HighWaterMark, m_LiveObjects);
+        return slot;
+    }
+
+    void ObjectPool::Free(const void* object)
+    {
+        byte* slab = (byte*)((uintptr_t)object & ~(uintptr_t)(SlabSize - 1));
+        ObjectPool* pool = ((Slab*)slab)->Pool;
+
+        byte* slots = slab + CacheLineSize;
+        void* slot = slots + ((byte*)object - slots) / pool->m_SlotSize * pool->m_SlotSize;
+
+        std::lock_guard<std::mutex> lock(pool->m_Mutex);
+        *(void**)slot = pool->m_FreeList;
+        pool->m_FreeList = slot;
+        pool->m_LiveObjects--;
+    }
+
+    ObjectPoolStats ObjectPool::GetStats()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        ObjectPoolStats stats;
+        stats.TypeName = m_TypeName;
+        stats.SlotSize = m_SlotSize;
+        stats.LiveObjects = m_LiveObjects;
+        stats.HighWaterMark = m_HighWaterMark;
+        stats.LiveBytes = (size_t)m_LiveObjects * m_SlotSize;
+        stats.ReservedBytes = (size_t)m_SlabCount * SlabSize;
+        return stats;
+    }
+
+    Vector<ObjectPoolStats> ObjectPool::GetAllStats()
+    {
+        std::lock_guard<std::mutex> lock(s_RegistryMutex);
+        Vector<ObjectPoolStats> stats;
+        for (ObjectPool* pool : GetRegistry())
+            stats.push_back(pool->GetStats());
+        return stats;
+    }
+}
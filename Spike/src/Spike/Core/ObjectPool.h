@@ -0,0 +1,78 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Core/Base.h"
+#include <mutex>
+#include <new>
+
+namespace Spike
+{
+    /* [Spike] Ref<T>::Create allocates T from an ObjectPool instead of the heap when this is specialized for T,
+     * use SPK_POOL_ALLOCATE(T) below the class declaration. It has to be the concrete type that gets created [Spike] */
+    template<typename T>
+    struct PoolAllocation
+    {
+        static constexpr bool Enabled = false;
+    };
+
+#define SPK_POOL_ALLOCATE(Type)                                 \
+    template<>                                                  \
+    struct PoolAllocation<Type>                                 \
+    {                                                           \
+        static constexpr bool Enabled = true;                   \
+        static constexpr const char* Name = #Type;              \
+    }
+
+    struct ObjectPoolStats
+    {
+        const char* TypeName = nullptr;
+        size_t SlotSize = 0;
+        Uint LiveObjects = 0;
+        Uint HighWaterMark = 0;   // Most objects alive at once
+        size_t LiveBytes = 0;
+        size_t ReservedBytes = 0; // Every slab, used or not
+    };
+
+    /* [Spike] Fixed size slots carved from 64 KB slabs, aligned to the slab size so any pointer into an object leads
+     * back to its slab and pool. Slots are cache line aligned and padded, freed slots go on a free list.
+     * Slabs are kept until exit, pools are never destroyed so statics holding Refs can still release them [Spike] */
+    class ObjectPool
+    {
+    public:
+        static constexpr size_t SlabSize = 64 * 1024;
+        static constexpr size_t CacheLineSize = 64;
+
+        void* Allocate();
+
+        /* [Spike] Returns the slot containing object to its pool, object may point to any base class sub object [Spike] */
+        static void Free(const void* object);
+
+        ObjectPoolStats GetStats();
+        static Vector<ObjectPoolStats> GetAllStats();
+
+        template<typename T>
+        static ObjectPool& Get()
+        {
+            static_assert(alignof(T) <= CacheLineSize, "Over aligned types can't be pool allocated!");
+            static_assert(sizeof(T) <= SlabSize / 8, "Type is too big to be pool allocated!");
+            static ObjectPool* pool = Register(PoolAllocation<T>::Name, sizeof(T));
+            return *pool;
+        }
+    private:
+        struct Slab;
+
+        ObjectPool(const char* typeName, size_t objectSize);
+        static ObjectPool* Register(const char* typeName, size_t objectSize);
+        void AddSlab();
+    private:
+        const char* m_TypeName;
+        size_t m_SlotSize;
+        Uint m_SlotsPerSlab;
+
+        std::mutex m_Mutex;
+        void* m_FreeList = nullptr;
+        Uint m_SlabCount = 0;
+        Uint m_LiveObjects = 0;
+        Uint m_HighWaterMark = 0;
+    };
+}
@@ -0,0 +1,259 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "Profiler.h"
+#include "Spike/Utility/Clock.h"
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+
+namespace Spike
+{
+    /* [Spike] Name is null for an end event. Both halves are relaxed atomics, so a capture can read a slot the owning
+     * thread is overwriting, notice it afterwards and throw the slot away [Spike] */
+    struct ProfileEvent
+    {
+        std::atomic<const char*> Name = nullptr;
+        std::atomic<int64_t> Timestamp = 0;
+    };
+
+    /* [Spike] Written by one thread only. Reserved is bumped before a slot is written and Head after, a reader that saw
+     * a slot being written also sees the Reserved value that marks it as overwritten [Spike] */
+    struct ProfileThreadBuffer
+    {
+        static constexpr Uint Mask = Profiler::EventsPerThread - 1;
+        static_assert((Profiler::EventsPerThread & Mask) == 0, "EventsPerThread must be a power of two!");
+
+        String Name; // Guarded by s_RegistryMutex
+        alignas(64) std::atomic<uint64_t> Reserved = 0;
+        std::atomic<uint64_t> Head = 0;
+        ProfileEvent Events[Profiler::EventsPerThread];
+    };
+
+    static Clock s_Clock;
+    static std::mutex s_RegistryMutex;
+    static thread_local ProfileThreadBuffer* s_ThreadBuffer = nullptr;
+
+    // Threads can exit while a capture still looks at their buffer, so buffers and names are never freed
+    static Vector<ProfileThreadBuffer*>& GetThreadBuffers()
+    {
+        static Vector<ProfileThreadBuffer*>* buffers = new Vector<ProfileThreadBuffer*>();
+        return *buffers;
+    }
+
+    static std::unordered_set<String>& GetInternedNames()
+    {
+        static std::unordered_set<String>* names = new std::unordered_set<String>();
+        return *names;
+    }
+
+    // Only touched by the main thread
+    static int64_t s_FrameEnds[Profiler::MaxCapturedFrames + 1];
+    static uint64_t s_FrameCount = 0;
+
+    static ProfileThreadBuffer& GetThreadBuffer()
+    {
+        if (!s_ThreadBuffer)
+        {
+            ProfileThreadBuffer* buffer = new ProfileThreadBuffer();
+            std::lock_guard<std::mutex> lock(s_RegistryMutex);
+            auto& buffers = GetThreadBuffers();
+            buffer->Name = "Thread " + std::to_string(buffers.size());
+            buffers.push_back(buffer);
+            s_ThreadBuffer = buffer;
+        }
+        return *s_ThreadBuffer;
+    }
+
+    static void PushEvent(const char* name)
+    {
+        ProfileThreadBuffer& buffer = GetThreadBuffer();
+        const uint64_t index = buffer.Head.load(std::memory_order_relaxed);
+        buffer.Reserved.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        ProfileEvent& event = buffer.Events[index & ProfileThreadBuffer::Mask];
+        event.Name.store(name, std::memory_order_relaxed);
+        event.Timestamp.store(Profiler::GetTimestamp(), std::memory_order_relaxed);
+        buffer.Head.store(index + 1, std::memory_order_release);
+    }
+
+    int64_t Profiler::GetTimestamp()
+    {
+        return s_Clock.GetElapsedTime().AsNanoseconds();
+    }
+
+    void Profiler::SetThreadName(const String& name)
+    {
+        ProfileThreadBuffer& buffer = GetThreadBuffer();
+        std::lock_guard<std::mutex> lock(s_RegistryMutex);
+        buffer.Name = name;
+    }
+
+    void Profiler::BeginScope(const char* name) { PushEvent(name); }
+    void Profiler::EndScope() { PushEvent(nullptr); }
+
+    void Profiler::EndFrame()
+    {
+        s_FrameEnds[s_FrameCount % (MaxCapturedFrames + 1)] = GetTimestamp();
+        s_FrameCount++;
+    }
+
+    const char* Profiler::InternName(const String& name)
+    {
+        std::lock_guard<std::mutex> lock(s_RegistryMutex);
+        return GetInternedNames().insert(name).first->c_str();
+    }
+
+    struct CapturedEvent
+    {
+        const char* Name;
+        int64_t Timestamp;
+    };
+
+    /* [Spike] Copies out what is left in the ring, drops the slots that were overwritten while copying [Spike] */
+    static Vector<CapturedEvent> CopyEvents(const ProfileThreadBuffer& buffer)
+    {
+        const uint64_t head = buffer.Head.load(std::memory_order_acquire);
+        uint64_t first = head > Profiler::EventsPerThread ? head - Profiler::EventsPerThread : 0;
+
+        Vector<CapturedEvent> events;
+        events.reserve((size_t)(head - first));
+        for (uint64_t index = first; index < head; index++)
+        {
+            const ProfileEvent& event = buffer.Events[index & ProfileThreadBuffer::Mask];
+            events.push_back({ event.Name.load(std::memory_order_relaxed), event.Timestamp.load(std::memory_order_relaxed) });
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t reserved = buffer.Reserved.load(std::memory_order_relaxed);
+        const uint64_t valid = reserved > Profiler::EventsPerThread ? reserved - Profiler::EventsPerThread : 0;
+        if (valid > first)
+            events.erase(events.begin(), events.begin() + (size_t)std::min<uint64_t>(valid - first, events.size()));
+        return events;
+    }
+
+    /* [Spike] Lost events are always the oldest ones, so an end without a begin only ever shows up before the first
+     * begin we still have. Scopes still open when the capture is taken end at the capture [Spike] */
+    static void BuildScopes(const Vector<CapturedEvent>& events, ProfileThreadCapture& thread, int64_t start, int64_t end)
+    {
+        Vector<CapturedEvent> stack;
+        auto emit = [&](const CapturedEvent& begin, int64_t scopeEnd)
+        {
+            if (scopeEnd < start || begin.Timestamp > end)
+                return;
+
+            const Uint depth = (Uint)stack.size();
+            thread.Scopes.push_back({ begin.Name, std::max(begin.Timestamp, start), std::min(scopeEnd, end), depth });
+            thread.MaxDepth = std::max(thread.MaxDepth, depth);
+        };
+
+        for (const CapturedEvent& event : events)
+        {
+            if (event.Name)
+            {
+                stack.push_back(event);
+                continue;
+            }
+            if (stack.empty())
+                continue;
+
+            CapturedEvent begin = stack.back();
+            stack.pop_back();
+            emit(begin, event.Timestamp);
+        }
+        while (!stack.empty())
+        {
+            CapturedEvent begin = stack.back();
+            stack.pop_back();
+            emit(begin, end);
+        }
+    }
+
+    ProfileCapture Profiler::Capture(Uint frames)
+    {
+        ProfileCapture capture;
+        capture.End = GetTimestamp();
+        capture.Start = 0;
+
+        frames = std::min(frames, MaxCapturedFrames);
+        const uint64_t storedFrames = std::min<uint64_t>(s_FrameCount, MaxCapturedFrames + 1);
+        if (storedFrames > 0 && frames > 0)
+        {
+            // The last frame end closes the window, the one frames before it opens it
+            capture.End = s_FrameEnds[(s_FrameCount - 1) % (MaxCapturedFrames + 1)];
+            if (storedFrames > frames)
+                capture.Start = s_FrameEnds[(s_FrameCount - 1 - frames) % (MaxCapturedFrames + 1)];
+            for (uint64_t i = std::min<uint64_t>(frames, storedFrames); i > 0; i--)
+                capture.FrameEnds.push_back(s_FrameEnds[(s_FrameCount - i) % (MaxCapturedFrames + 1)]);
+        }
+
+        Vector<std::pair<ProfileThreadBuffer*, String>> threads;
+        {
+            std::lock_guard<std::mutex> lock(s_RegistryMutex);
+            for (ProfileThreadBuffer* buffer : GetThreadBuffers())
+                threads.push_back({ buffer, buffer->Name });
+        }
+
+        for (auto& [buffer, name] : threads)
+        {
+            ProfileThreadCapture thread;
+            thread.Name = name;
+            BuildScopes(CopyEvents(*buffer), thread, capture.Start, capture.End);
+            if (!thread.Scopes.empty())
+                capture.Threads.push_back(std::move(thread));
+        }
+        return capture;
+    }
+
+    static void WriteJsonString(FILE* file, const char* string)
+    {
+        fputc('"', file);
+        for (const char* c = string; *c; c++)
+        {
+            if (*c == '"' || *c == '\\')
+                fputc('\\', file);
+            if ((unsigned char)*c >= 0x20)
+                fputc(*c, file);
+        }
+        fputc('"', file);
+    }
+
+    bool Profiler::ExportChromeTrace(const String& filepath, Uint frames)
+    {
+        std::filesystem::path path{ filepath };
+        if (path.has_parent_path())
+            std::filesystem::create_directories(path.parent_path());
+
+        FILE* file = fopen(filepath.c_str(), "w");
+        if (!file)
+            return false;
+
+        const ProfileCapture capture = Capture(frames);
+        auto toMicroseconds = [&](int64_t timestamp) { return (timestamp - capture.Start) / 1000.0; };
+
+        fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Spike\"}}");
+        for (size_t tid = 0; tid < capture.Threads.size(); tid++)
+        {
+            const ProfileThreadCapture& thread = capture.Threads[tid];
+            fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"args\":{\"name\":", tid);
+            WriteJsonString(file, thread.Name.c_str());
+            fprintf(file, "}}");
+
+            for (const ProfileScopeRecord& scope : thread.Scopes)
+            {
+                fprintf(file, ",\n{\"name\":");
+                WriteJsonString(file, scope.Name);
+                fprintf(file, ",\"cat\":\"Spike\",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f}", tid,
+                    toMicroseconds(scope.Start), (scope.End - scope.Start) / 1000.0);
+            }
+        }
+        for (int64_t frameEnd : capture.FrameEnds)
+            fprintf(file, ",\n{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":%.3f}", toMicroseconds(frameEnd));
+        fprintf(file, "\n]}\n");
+        fclose(file);
+        return true;
+    }
+}
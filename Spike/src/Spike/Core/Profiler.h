@@ -0,0 +1,96 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Core/Base.h"
+
+/* [Spike] On in Debug and RelWithDebInfo, define SPK_PROFILE yourself to profile any other configuration [Spike] */
+#if defined(SPK_DEBUG) && !defined(SPK_PROFILE)
+    #define SPK_PROFILE
+#endif
+
+namespace Spike
+{
+    struct ProfileScopeRecord
+    {
+        const char* Name;
+        int64_t Start, End; // Nanoseconds since the profiler started
+        Uint Depth;
+    };
+
+    struct ProfileThreadCapture
+    {
+        String Name;
+        Uint MaxDepth = 0;
+        Vector<ProfileScopeRecord> Scopes;
+    };
+
+    struct ProfileCapture
+    {
+        int64_t Start = 0, End = 0;
+        Vector<int64_t> FrameEnds; // Frame boundaries inside [Start, End]
+        Vector<ProfileThreadCapture> Threads;
+
+        float GetMilliseconds() const { return (End - Start) / 1000000.0f; }
+    };
+
+    /* [Spike] Every thread writes begin and end events into its own ring buffer, without locks. The oldest events are
+     * overwritten, a capture turns whatever is still in the rings into scopes. Scope names are kept as pointers, so they
+     * have to live for the whole run: string literals, or InternName for names built at runtime.
+     * The SPK_PROFILE macros only do something in builds with SPK_DEBUG, release builds compile them out [Spike] */
+    class Profiler
+    {
+    public:
+        static constexpr Uint EventsPerThread = 32768;
+        static constexpr Uint MaxCapturedFrames = 64;
+
+        static constexpr bool IsEnabled()
+        {
+#ifdef SPK_PROFILE
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        static void SetThreadName(const String& name);
+        static void BeginScope(const char* name);
+        static void EndScope();
+
+        /* [Spike] Marks the end of a frame, Application::Run calls it once per frame [Spike] */
+        static void EndFrame();
+
+        static int64_t GetTimestamp();
+        static const char* InternName(const String& name);
+
+        /* [Spike] The scopes of every thread over the last frames complete frames. Main thread only [Spike] */
+        static ProfileCapture Capture(Uint frames);
+
+        /* [Spike] Writes a capture in the Chrome trace event format, chrome://tracing and ui.perfetto.dev open it [Spike] */
+        static bool ExportChromeTrace(const String& filepath, Uint frames = MaxCapturedFrames);
+    };
+
+    class ProfileScope
+    {
+    public:
+        ProfileScope(const char* name) { Profiler::BeginScope(name); }
+        ~ProfileScope() { Profiler::EndScope(); }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+    };
+}
+
+#ifdef SPK_PROFILE
+    #if defined(_MSC_VER)
+        #define SPK_PROFILE_FUNCTION_NAME __FUNCTION__
+    #else
+        #define SPK_PROFILE_FUNCTION_NAME __PRETTY_FUNCTION__
+    #endif
+    #define SPK_PROFILE_CONCAT_INNER(a, b) a##b
+    #define SPK_PROFILE_CONCAT(a, b) SPK_PROFILE_CONCAT_INNER(a, b)
+    #define SPK_PROFILE_SCOPE(name) ::Spike::ProfileScope SPK_PROFILE_CONCAT(profileScope, __LINE__)(name)
+    #define SPK_PROFILE_FUNCTION() SPK_PROFILE_SCOPE(SPK_PROFILE_FUNCTION_NAME)
+#else
+    #define SPK_PROFILE_SCOPE(name)
+    #define SPK_PROFILE_FUNCTION()
+#endif
@@ -0,0 +1,74 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "Ref.h"
+#include "Spike/Utility/Clock.h"
+
+namespace Spike
+{
+    /* [Spike] The Ref from before the count went atomic, only kept around to benchmark against [Spike] */
+    struct PlainCounted
+    {
+        Uint RefCount = 0;
+        int Value = 1;
+    };
+
+    class PlainRef
+    {
+    public:
+        PlainRef(PlainCounted* instance) : m_Instance(instance) { m_Instance->RefCount++; }
+        PlainRef(const PlainRef& other) : m_Instance(other.m_Instance) { m_Instance->RefCount++; }
+        ~PlainRef()
+        {
+            if (--m_Instance->RefCount == 0)
+                delete m_Instance;
+        }
+
+        PlainCounted* operator->() const { return m_Instance; }
+    private:
+        PlainCounted* m_Instance;
+    };
+
+    struct BenchmarkCounted : public RefCounted
+    {
+        int Value = 1;
+    };
+
+    static int SubmitPlainByValue(PlainRef ref) { return ref->Value; }
+    static int SubmitByValue(Ref<BenchmarkCounted> ref) { return ref->Value; }
+    static int SubmitByReference(const Ref<BenchmarkCounted>& ref) { return ref->Value; }
+
+    // Called through volatile pointers so the compiler can't inline the calls and drop the reference counting
+    static int (*volatile s_SubmitPlainByValue)(PlainRef) = SubmitPlainByValue;
+    static int (*volatile s_SubmitByValue)(Ref<BenchmarkCounted>) = SubmitByValue;
+    static int (*volatile s_SubmitByReference)(const Ref<BenchmarkCounted>&) = SubmitByReference;
+
+    RefCountBenchmark BenchmarkRefCounting(Uint iterations)
+    {
+        RefCountBenchmark result;
+        result.Iterations = iterations;
+        volatile int sink = 0;
+        Clock clock;
+
+        {
+            PlainRef plain(new PlainCounted());
+            clock.Reset();
+            for (Uint i = 0; i < iterations; i++)
+                sink = sink + s_SubmitPlainByValue(plain);
+            result.PlainByValueMilliseconds = clock.GetElapsedTime().AsNanoseconds() / 1000000.0;
+        }
+
+        Ref<BenchmarkCounted> object = Ref<BenchmarkCounted>::Create();
+        clock.Reset();
+        for (Uint i = 0; i < iterations; i++)
+            sink = sink + s_SubmitByValue(object);
+        result.AtomicByValueMilliseconds = clock.GetElapsedTime().AsNanoseconds() / 1000000.0;
+
+        clock.Reset();
+        for (Uint i = 0; i < iterations; i++)
+            sink = sink + s_SubmitByReference(object);
+        result.AtomicByReferenceMilliseconds = clock.GetElapsedTime().AsNanoseconds() / 1000000.0;
+
+        return result;
+    }
+}
@@ -2,6 +2,9 @@
 //Copyright 2021 - SpikeTechnologies - All Rights Reserved
 #pragma once
 #include "Spike/Core/Log.h"
+#include "Spike/Core/ObjectPool.h"
+#include <atomic>
+#include <mutex>
 #include <stdint.h>
 
 namespace Spike
@@ -16,23 +19,93 @@ namespace Spike
 #endif
 
 
+    /* [Spike] Shared by an object and every WeakRef to it. Outlives the object until the last WeakRef is gone [Spike] */
+    struct WeakRefControl
+    {
+        std::atomic<Uint> References = 1; // Every WeakRef, plus one held by the object while it is alive
+        std::atomic<bool> Alive = true;
+        std::mutex Mutex; // Held while locking a WeakRef and while the last Ref gives up the object
+
+        void Release()
+        {
+            if (References.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                delete this;
+        }
+    };
+
+    /* [Spike] Increments are relaxed, nothing is published through them. Decrements are acq_rel so everything done through
+     * other Refs happens before the destructor runs on whichever thread drops the last one [Spike] */
     class RefCounted
     {
     public:
+        RefCounted() = default;
+        RefCounted(const RefCounted&) {} // A copy is a new object, it doesn't inherit any references
+        RefCounted& operator=(const RefCounted&) { return *this; }
+
         void IncRefCount() const
         {
-            m_RefCount++;
+            m_RefCount.fetch_add(1, std::memory_order_relaxed);
             SPK_REF_LOG_INCREMENT("REF incremented!");
         }
-        void DecRefCount() const
+
+        /* [Spike] Returns true when that was the last reference, the caller then destroys the object [Spike] */
+        bool DecRefCount() const
         {
-            m_RefCount--;
             SPK_REF_LOG_DECREMENT("REF decremented!");
+            if (m_RefCount.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return false;
+
+            WeakRefControl* control = m_WeakControl.load(std::memory_order_acquire);
+            if (control)
+            {
+                {
+                    // Waits for a WeakRef::Lock() that may still be looking at the object
+                    std::lock_guard<std::mutex> lock(control->Mutex);
+                    control->Alive.store(false, std::memory_order_release);
+                }
+                control->Release();
+            }
+            return true;
         }
 
-        Uint GetRefCount() const { return m_RefCount; }
+        Uint GetRefCount() const { return m_RefCount.load(std::memory_order_relaxed); }
+        bool IsPoolAllocated() const { return m_PoolAllocated; }
     private:
-        mutable Uint m_RefCount = 0; // TODO: atomic
+        /* [Spike] Only succeeds while somebody else still holds a reference [Spike] */
+        bool TryIncRefCount() const
+        {
+            Uint count = m_RefCount.load(std::memory_order_relaxed);
+            while (count != 0)
+            {
+                if (m_RefCount.compare_exchange_weak(count, count + 1, std::memory_order_relaxed))
+                    return true;
+            }
+            return false;
+        }
+
+        WeakRefControl* AcquireWeakControl() const
+        {
+            WeakRefControl* control = m_WeakControl.load(std::memory_order_acquire);
+            if (!control)
+            {
+                WeakRefControl* created = new WeakRefControl();
+                if (m_WeakControl.compare_exchange_strong(control, created, std::memory_order_acq_rel, std::memory_order_acquire))
+                    control = created;
+                else
+                    delete created;
+            }
+            control->References.fetch_add(1, std::memory_order_relaxed);
+            return control;
+        }
+    private:
+        mutable std::atomic<Uint> m_RefCount = 0;
+        mutable std::atomic<WeakRefControl*> m_WeakControl = nullptr;
+        bool m_PoolAllocated = false;
+
+        template<class T>
+        friend class Ref;
+        template<class T>
+        friend class WeakRef;
     };
 
     template<typename T>
@@ -77,6 +150,12 @@ namespace Spike
             IncRef();
         }
 
+        Ref(Ref<T>&& other) noexcept
+            : m_Instance(other.m_Instance)
+        {
+            other.m_Instance = nullptr;
+        }
+
         Ref& operator=(std::nullptr_t)
         {
             DecRef();
@@ -103,6 +182,17 @@ namespace Spike
             return *this;
         }
 
+        Ref& operator=(Ref<T>&& other) noexcept
+        {
+            if (this != &other)
+            {
+                DecRef();
+                m_Instance = other.m_Instance;
+                other.m_Instance = nullptr;
+            }
+            return *this;
+        }
+
         template<typename T2>
         Ref& operator=(Ref<T2>&& other)
         {
@@ -116,27 +206,39 @@ namespace Spike
         operator bool() { return m_Instance != nullptr; }
         operator bool() const { return m_Instance != nullptr; }
 
-        T* operator->() { return m_Instance; }
-        const T* operator->() const { return m_Instance; }
-
-        T& operator*() { return *m_Instance; }
-        const T& operator*() const { return *m_Instance; }
-
-        T* Raw() { return  m_Instance; }
-        const T* Raw() const { return  m_Instance; }
+        /* [Spike] Const like a pointer, a const Ref can't be pointed elsewhere but the object stays usable [Spike] */
+        T* operator->() const { return m_Instance; }
+        T& operator*() const { return *m_Instance; }
+        T* Raw() const { return  m_Instance; }
 
         void Reset(T* instance = nullptr)
         {
             DecRef();
             m_Instance = instance;
+            IncRef();
         }
 
         template<typename... Args>
         static Ref<T> Create(Args&&... args)
         {
-            return Ref<T>(new T(std::forward<Args>(args)...));
+            if constexpr (PoolAllocation<T>::Enabled)
+            {
+                T* instance = new (ObjectPool::Get<T>().Allocate()) T(std::forward<Args>(args)...);
+                instance->m_PoolAllocated = true;
+                return Ref<T>(instance);
+            }
+            else
+                return Ref<T>(new T(std::forward<Args>(args)...));
         }
     private:
+        /* [Spike] Takes over a reference that was already counted [Spike] */
+        static Ref<T> Adopt(T* instance)
+        {
+            Ref<T> ref;
+            ref.m_Instance = instance;
+            return ref;
+        }
+
         void IncRef() const
         {
             if (m_Instance)
@@ -147,15 +249,120 @@ namespace Spike
         {
             if (m_Instance)
             {
-                m_Instance->DecRefCount();
-                if (m_Instance->GetRefCount() == 0)
-                    delete m_Instance;
+                if (m_Instance->DecRefCount())
+                {
+                    if (m_Instance->IsPoolAllocated())
+                    {
+                        // Destroys the most derived object through the virtual destructor, the pool finds the slot from any base
+                        const void* object = m_Instance;
+                        m_Instance->~T();
+                        ObjectPool::Free(object);
+                    }
+                    else
+                        delete m_Instance;
+                }
             }
         }
 
         template<class T2>
         friend class Ref;
+        template<class T2>
+        friend class WeakRef;
         T* m_Instance;
     };
-    // TODO: WeakRef
+
+    /* [Spike] Doesn't keep the object alive. Lock() hands out a Ref if it still is, from any thread [Spike] */
+    template<typename T>
+    class WeakRef
+    {
+    public:
+        WeakRef() = default;
+        WeakRef(std::nullptr_t) {}
+
+        template<typename T2>
+        WeakRef(const Ref<T2>& ref)
+            : m_Instance(ref.m_Instance)
+        {
+            if (m_Instance)
+                m_Control = m_Instance->AcquireWeakControl();
+        }
+
+        WeakRef(const WeakRef<T>& other)
+            : m_Instance(other.m_Instance), m_Control(other.m_Control)
+        {
+            if (m_Control)
+                m_Control->References.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        WeakRef(WeakRef<T>&& other) noexcept
+            : m_Instance(other.m_Instance), m_Control(other.m_Control)
+        {
+            other.m_Instance = nullptr;
+            other.m_Control = nullptr;
+        }
+
+        ~WeakRef()
+        {
+            Reset();
+        }
+
+        WeakRef& operator=(const WeakRef<T>& other)
+        {
+            if (other.m_Control)
+                other.m_Control->References.fetch_add(1, std::memory_order_relaxed);
+            Reset();
+            m_Instance = other.m_Instance;
+            m_Control = other.m_Control;
+            return *this;
+        }
+
+        WeakRef& operator=(WeakRef<T>&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Reset();
+                m_Instance = other.m_Instance;
+                m_Control = other.m_Control;
+                other.m_Instance = nullptr;
+                other.m_Control = nullptr;
+            }
+            return *this;
+        }
+
+        Ref<T> Lock() const
+        {
+            if (!m_Control)
+                return nullptr;
+
+            std::lock_guard<std::mutex> lock(m_Control->Mutex);
+            if (!m_Control->Alive.load(std::memory_order_acquire) || !m_Instance->TryIncRefCount())
+                return nullptr;
+            return Ref<T>::Adopt(m_Instance);
+        }
+
+        /* [Spike] Only a hint when other threads hold Refs, use Lock() to actually get at the object [Spike] */
+        bool IsExpired() const { return !m_Control || !m_Control->Alive.load(std::memory_order_acquire); }
+
+        void Reset()
+        {
+            if (m_Control)
+                m_Control->Release();
+            m_Instance = nullptr;
+            m_Control = nullptr;
+        }
+    private:
+        T* m_Instance = nullptr;
+        WeakRefControl* m_Control = nullptr;
+    };
+
+    struct RefCountBenchmark
+    {
+        Uint Iterations = 0;
+        double PlainByValueMilliseconds = 0.0;      // Plain Uint count, Ref passed by value, how SubmitMesh used to work
+        double AtomicByValueMilliseconds = 0.0;     // Atomic count, Ref passed by value
+        double AtomicByReferenceMilliseconds = 0.0; // Atomic count, Ref passed by reference or moved
+    };
+
+    /* [Spike] Passes a Ref to a function that isn't inlined, iterations times for each variant [Spike] */
+    RefCountBenchmark BenchmarkRefCounting(Uint iterations = 10000000);
 }
\ No newline at end of file
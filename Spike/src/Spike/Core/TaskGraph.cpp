@@ -0,0 +1,261 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "TaskGraph.h"
+#include "Spike/Core/JobSystem.h"
+#include "Spike/Core/Profiler.h"
+#include "Spike/Core/FrameStats.h"
+#include <cstring>
+#if defined(__GNUC__) || defined(__clang__)
+    #include <cxxabi.h>
+#endif
+
+namespace Spike
+{
+    TaskGraph::TaskBuilder TaskGraph::AddTask(const String& name, TaskAffinity affinity, std::function<void()> function)
+    {
+        Task task;
+        task.Name = name;
+        task.ProfileName = Profiler::InternName(name);
+        task.Affinity = affinity;
+        task.Function = std::move(function);
+        m_Tasks.push_back(std::move(task));
+        m_Dirty = true;
+        return TaskBuilder(*this, (Uint)m_Tasks.size() - 1);
+    }
+
+    void TaskGraph::AddAccess(Uint task, const char* resource, bool write)
+    {
+        Uint index = 0;
+        while (index < m_Resources.size() && m_Resources[index] != resource)
+            index++;
+        if (index == m_Resources.size())
+            m_Resources.push_back(resource);
+
+        auto& accesses = write ? m_Tasks[task].Writes : m_Tasks[task].Reads;
+        if (std::find(accesses.begin(), accesses.end(), index) == accesses.end())
+            accesses.push_back(index);
+        m_Dirty = true;
+    }
+
+    static bool Contains(const Vector<Uint>& resources, Uint resource)
+    {
+        return std::find(resources.begin(), resources.end(), resource) != resources.end();
+    }
+
+    void TaskGraph::Build()
+    {
+        /* [Spike] A later task depends on an earlier one when either writes something the other one touches.
+         * Edges already implied by another dependency are left out, which keeps the dump readable [Spike] */
+        Vector<Vector<bool>> reaches(m_Tasks.size(), Vector<bool>(m_Tasks.size(), false));
+        for (Uint i = 0; i < m_Tasks.size(); i++)
+        {
+            Task& task = m_Tasks[i];
+            task.Dependencies.clear();
+            task.Dependents.clear();
+
+            for (Uint j = i; j-- > 0;)
+            {
+                const Task& earlier = m_Tasks[j];
+                bool conflict = false;
+                for (Uint resource : earlier.Writes)
+                    conflict |= Contains(task.Reads, resource) || Contains(task.Writes, resource);
+                for (Uint resource : earlier.Reads)
+                    conflict |= Contains(task.Writes, resource);
+                if (!conflict || reaches[i][j])
+                    continue;
+
+                // Walking backwards, so the closest conflicts are added first and make the older ones redundant
+                task.Dependencies.push_back(j);
+                reaches[i][j] = true;
+                for (Uint k = 0; k < j; k++)
+                    reaches[i][k] = reaches[i][k] || reaches[j][k];
+            }
+
+            for (Uint dependency : task.Dependencies)
+                m_Tasks[dependency].Dependents.push_back(i);
+        }
+
+        m_PendingDependencies = Scope<std::atomic<Uint>[]>(new std::atomic<Uint>[m_Tasks.size()]);
+        m_Dirty = false;
+    }
+
+    void TaskGraph::Execute()
+    {
+        SPK_PROFILE_FUNCTION();
+        if (m_Dirty)
+            Build();
+
+        m_FrameClock.Reset();
+        if (JobSystem::IsInitialized())
+        {
+            SPK_CORE_ASSERT(JobSystem::IsMainThread(), "TaskGraph::Execute must be called from the main thread!");
+            for (Uint i = 0; i < m_Tasks.size(); i++)
+                m_PendingDependencies[i].store((Uint)m_Tasks[i].Dependencies.size(), std::memory_order_relaxed);
+
+            JobCounter counter;
+            for (Uint i = 0; i < m_Tasks.size(); i++)
+            {
+                if (m_Tasks[i].Dependencies.empty())
+                    Launch(i, counter);
+            }
+            JobSystem::Wait(counter);
+        }
+        else
+        {
+            // Tools and headless runs without a JobSystem, the tasks are stored in a topological order
+            for (Task& task : m_Tasks)
+                Invoke(task);
+        }
+        m_FrameMilliseconds = m_FrameClock.GetElapsedTime().AsNanoseconds() / 1000000.0f;
+
+        for (const Task& task : m_Tasks)
+            FrameStats::RecordSystem(task.ProfileName, (task.EndNanoseconds - task.StartNanoseconds) / 1000000.0f);
+    }
+
+    void TaskGraph::Launch(Uint task, JobCounter& counter)
+    {
+        auto job = [this, task, &counter]() { RunTask(task, counter); };
+        if (m_Tasks[task].Affinity == TaskAffinity::MainThread)
+            JobSystem::RunOnMainThread(job, &counter);
+        else
+            JobSystem::Run(job, &counter);
+    }
+
+    void TaskGraph::Invoke(Task& task)
+    {
+        SPK_PROFILE_SCOPE(task.ProfileName);
+        task.StartNanoseconds = m_FrameClock.GetElapsedTime().AsNanoseconds();
+        task.Function();
+        task.EndNanoseconds = m_FrameClock.GetElapsedTime().AsNanoseconds();
+    }
+
+    void TaskGraph::RunTask(Uint index, JobCounter& counter)
+    {
+        Task& task = m_Tasks[index];
+        Invoke(task);
+
+        // Launched from inside this job, so the counter can't reach zero before they are queued
+        for (Uint dependent : task.Dependents)
+        {
+            if (m_PendingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Launch(dependent, counter);
+        }
+    }
+
+    Vector<Uint> TaskGraph::FindCriticalPath() const
+    {
+        /* [Spike] Tasks are stored in a topological order, so one pass finds the longest chain of measured durations [Spike] */
+        Vector<int64_t> finish(m_Tasks.size(), 0);
+        Vector<int> previous(m_Tasks.size(), -1);
+        int last = -1;
+        for (Uint i = 0; i < m_Tasks.size(); i++)
+        {
+            int64_t start = 0;
+            for (Uint dependency : m_Tasks[i].Dependencies)
+            {
+                if (finish[dependency] > start)
+                {
+                    start = finish[dependency];
+                    previous[i] = (int)dependency;
+                }
+            }
+            finish[i] = start + (m_Tasks[i].EndNanoseconds - m_Tasks[i].StartNanoseconds);
+            if (last == -1 || finish[i] > finish[last])
+                last = (int)i;
+        }
+
+        Vector<Uint> path;
+        for (int task = last; task != -1; task = previous[task])
+            path.insert(path.begin(), (Uint)task);
+        return path;
+    }
+
+    Vector<TaskGraph::TaskStats> TaskGraph::GetTaskStats() const
+    {
+        Vector<Uint> criticalPath = FindCriticalPath();
+        Vector<TaskStats> stats;
+        stats.reserve(m_Tasks.size());
+        for (Uint i = 0; i < m_Tasks.size(); i++)
+        {
+            const Task& task = m_Tasks[i];
+            TaskStats stat;
+            stat.Name = task.Name.c_str();
+            stat.MainThread = task.Affinity == TaskAffinity::MainThread;
+            stat.OnCriticalPath = Contains(criticalPath, i);
+            stat.StartMilliseconds = task.StartNanoseconds / 1000000.0f;
+            stat.Milliseconds = (task.EndNanoseconds - task.StartNanoseconds) / 1000000.0f;
+            stats.push_back(stat);
+        }
+        return stats;
+    }
+
+    float TaskGraph::GetCriticalPathMilliseconds() const
+    {
+        int64_t total = 0;
+        for (Uint task : FindCriticalPath())
+            total += m_Tasks[task].EndNanoseconds - m_Tasks[task].StartNanoseconds;
+        return total / 1000000.0f;
+    }
+
+    String TaskGraph::Dump() const
+    {
+        auto joinResources = [this](const Vector<Uint>& resources)
+        {
+            String result;
+            for (Uint resource : resources)
+                result += (result.empty() ? "" : ", ") + m_Resources[resource];
+            return result.empty() ? String("-") : result;
+        };
+
+        std::ostringstream out;
+        out.setf(std::ios::fixed);
+        out.precision(3);
+        out << "TaskGraph '" << m_Name << "': " << m_Tasks.size() << " tasks, " << m_FrameMilliseconds << " ms, critical path "
+            << GetCriticalPathMilliseconds() << " ms\n";
+
+        for (Uint i = 0; i < m_Tasks.size(); i++)
+        {
+            const Task& task = m_Tasks[i];
+            out << "  [" << i << "] " << task.Name << (task.Affinity == TaskAffinity::MainThread ? " (main thread)" : "")
+                << "  start " << task.StartNanoseconds / 1000000.0 << " ms, took "
+                << (task.EndNanoseconds - task.StartNanoseconds) / 1000000.0 << " ms\n";
+            out << "      reads:  " << joinResources(task.Reads) << "\n";
+            out << "      writes: " << joinResources(task.Writes) << "\n";
+            out << "      after:  ";
+            if (task.Dependencies.empty())
+                out << "-";
+            for (Uint d = 0; d < task.Dependencies.size(); d++)
+                out << (d ? ", " : "") << m_Tasks[task.Dependencies[d]].Name;
+            out << "\n";
+        }
+
+        out << "  Critical path: ";
+        Vector<Uint> criticalPath = FindCriticalPath();
+        for (Uint i = 0; i < criticalPath.size(); i++)
+            out << (i ? " -> " : "") << m_Tasks[criticalPath[i]].Name;
+        out << "\n";
+        return out.str();
+    }
+
+    String TaskGraph::CleanTypeName(const char* name)
+    {
+        String result = name;
+#if defined(__GNUC__) || defined(__clang__)
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (status == 0 && demangled)
+            result = demangled;
+        free(demangled);
+#endif
+        // MSVC prefixes the kind
+        for (const char* prefix : { "struct ", "class " })
+        {
+            if (result.rfind(prefix, 0) == 0)
+                result.erase(0, strlen(prefix));
+        }
+        if (result.rfind("Spike::", 0) == 0)
+            result.erase(0, strlen("Spike::"));
+        return result;
+    }
+}
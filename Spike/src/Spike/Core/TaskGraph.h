@@ -0,0 +1,107 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Core/Base.h"
+#include "Spike/Utility/Clock.h"
+#include <atomic>
+#include <functional>
+#include <typeinfo>
+
+namespace Spike
+{
+    class JobCounter;
+
+    enum class TaskAffinity
+    {
+        AnyThread = 0,
+        MainThread // Graphics context, Mono
+    };
+
+    /* [Spike] A set of tasks that declare which resources (component types, or named things like "Renderer2D") they read
+     * and write. A task runs after every earlier task it conflicts with, everything else runs concurrently on the
+     * JobSystem. Dependencies are derived once and cached until a task is added [Spike] */
+    class TaskGraph
+    {
+    public:
+        class TaskBuilder
+        {
+        public:
+            TaskBuilder(TaskGraph& graph, Uint task)
+                :m_Graph(graph), m_Task(task) {}
+
+            template<typename... Components>
+            TaskBuilder& Reads() { (m_Graph.AddAccess(m_Task, GetResourceName<Components>(), false), ...); return *this; }
+
+            template<typename... Components>
+            TaskBuilder& Writes() { (m_Graph.AddAccess(m_Task, GetResourceName<Components>(), true), ...); return *this; }
+
+            TaskBuilder& Reads(const char* resource) { m_Graph.AddAccess(m_Task, resource, false); return *this; }
+            TaskBuilder& Writes(const char* resource) { m_Graph.AddAccess(m_Task, resource, true); return *this; }
+        private:
+            TaskGraph& m_Graph;
+            Uint m_Task;
+        };
+
+        TaskGraph(const String& name)
+            :m_Name(name) {}
+
+        /* [Spike] Tasks added earlier win conflicts, so declaring them in the old serial order keeps its results [Spike] */
+        TaskBuilder AddTask(const String& name, TaskAffinity affinity, std::function<void()> function);
+
+        /* [Spike] Runs every task and returns when all of them are done. Must be called from the main thread. Without an
+         * initialized JobSystem the tasks run one after another on the calling thread [Spike] */
+        void Execute();
+
+        struct TaskStats
+        {
+            const char* Name;
+            bool MainThread;
+            bool OnCriticalPath;
+            float StartMilliseconds; // Since Execute() started
+            float Milliseconds;
+        };
+
+        const String& GetName() const { return m_Name; }
+        Vector<TaskStats> GetTaskStats() const;
+        float GetFrameMilliseconds() const { return m_FrameMilliseconds; }
+        float GetCriticalPathMilliseconds() const;
+
+        /* [Spike] Every task with its accesses, dependencies and the timings of the last Execute(), then the critical path [Spike] */
+        String Dump() const;
+
+        template<typename T>
+        static const char* GetResourceName()
+        {
+            static const String name = CleanTypeName(typeid(T).name());
+            return name.c_str();
+        }
+    private:
+        struct Task
+        {
+            String Name;
+            const char* ProfileName; // Interned, outlives the graph, for the Profiler and FrameStats
+            TaskAffinity Affinity;
+            std::function<void()> Function;
+            Vector<Uint> Reads, Writes; // Indices into m_Resources
+            Vector<Uint> Dependencies, Dependents;
+            int64_t StartNanoseconds = 0, EndNanoseconds = 0;
+        };
+
+        void AddAccess(Uint task, const char* resource, bool write);
+        void Build();
+        void Launch(Uint task, JobCounter& counter);
+        void Invoke(Task& task);
+        void RunTask(Uint task, JobCounter& counter);
+        Vector<Uint> FindCriticalPath() const;
+        static String CleanTypeName(const char* name);
+    private:
+        String m_Name;
+        Vector<Task> m_Tasks;
+        Vector<String> m_Resources;
+        Scope<std::atomic<Uint>[]> m_PendingDependencies;
+        bool m_Dirty = true;
+
+        Clock m_FrameClock;
+        float m_FrameMilliseconds = 0.0f;
+    };
+}
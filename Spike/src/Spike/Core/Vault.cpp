@@ -2,6 +2,8 @@
 //Copyright 2021 - SpikeTechnologies - All Rights Reserved
 #include "spkpch.h"
 #include "Vault.h"
+#include "Spike/Core/MemoryTracker.h"
+#include "Spike/Core/Profiler.h"
 #include <filesystem>
 
 namespace Spike
@@ -10,10 +12,11 @@ namespace Spike
     bool Vault::s_VaultInitialized = false;
     std::unordered_map<String, Ref<Shader>>             Vault::s_Shaders;
     std::unordered_map<String, Ref<Texture2D>>          Vault::s_Textures;
-    std::unordered_map<String, String>                  Vault::s_Scripts;
+    std::unordered_set<String>                          Vault::s_Scripts;
 
     void Vault::Init(const String& projectPath)
     {
+        SPK_MEMORY_TAG(Vault);
         if (s_VaultInitialized)
             Vault::Shutdown();
 
@@ -30,6 +33,8 @@ namespace Spike
 
     bool Vault::Reload()
     {
+        SPK_MEMORY_TAG(Vault);
+        SPK_PROFILE_FUNCTION();
         Vault::ClearAllCache();
         for (const auto& entry : std::filesystem::recursive_directory_iterator(s_ProjectPath))
         {
@@ -50,7 +55,7 @@ namespace Spike
             }
             if (GetExtension(entry.path().string()) == ".cs")
             {
-                s_Scripts[entry.path().string()] = ReadFile(entry.path().string());
+                s_Scripts.insert(entry.path().string());
             }
         }
         return true;
@@ -84,7 +89,7 @@ namespace Spike
 
         case ResourceType::SCRIPT:
             for (auto& script : s_Scripts)
-                if (GetNameWithExtension(script.first) == nameWithExtension)
+                if (GetNameWithExtension(script) == nameWithExtension)
                     return true;
         }
         return false;
@@ -105,17 +110,16 @@ namespace Spike
                     return true;
 
         case Spike::ResourceType::SCRIPT:
-            for (auto& script : s_Scripts)
-                if (script.first == path)
-                    return true;
+            if (s_Scripts.find(path) != s_Scripts.end())
+                return true;
         }
         return false;
     }
 
-    Vector<Ref<Shader>> Vault::GetAllShaders()
+    FrameVector<Ref<Shader>> Vault::GetAllShaders()
     {
-        Vector<Ref<Shader>> shaders;
-        shaders.resize(s_Shaders.size());
+        FrameVector<Ref<Shader>> shaders;
+        shaders.reserve(s_Shaders.size());
         for (auto& shader : s_Shaders)
         {
             shaders.emplace_back(shader.second);
@@ -123,10 +127,10 @@ namespace Spike
         return shaders;
     }
 
-    Vector<Ref<Texture>> Vault::GetAllTextures()
+    FrameVector<Ref<Texture>> Vault::GetAllTextures()
     {
-        Vector<Ref<Texture>> textures;
-        textures.resize(s_Textures.size());
+        FrameVector<Ref<Texture>> textures;
+        textures.reserve(s_Textures.size());
         for (auto& texture : s_Textures)
         {
             textures.emplace_back(texture.second);
@@ -152,7 +156,7 @@ namespace Spike
         return names;
     }
 
-    std::unordered_map<String, String> Vault::GetAllScripts()
+    const std::unordered_set<String>& Vault::GetAllScripts()
     {
         return s_Scripts;
     }
@@ -172,40 +176,26 @@ namespace Spike
         s_Scripts.clear();
     }
 
-    String Vault::ReadFile(const String& filepath)
+    MappedFile Vault::MapFile(const String& filepath, FileAccessHint hint)
     {
-        String result;
-        std::ifstream in(filepath, std::ios::in | std::ios::binary); // ifstream closes itself due to RAII
-        if (in)
-        {
-            in.seekg(0, std::ios::end);
-            result.resize(in.tellg());
-            in.seekg(0, std::ios::beg);
-            in.read(&result[0], result.size());
-        }
-        else
-        {
+        MappedFile file(filepath, hint);
+        if (!file)
             SPK_CORE_LOG_CRITICAL("Could not open file path \"%s\"", filepath.c_str());
-        }
-        return result;
+        return file;
     }
 
-    Vector<char> Vault::ReadBinaryFile(const String& filepath)
+    String Vault::ReadFile(const String& filepath)
     {
-        std::ifstream stream(filepath, std::ios::binary | std::ios::ate);
-
-        if (!stream)
-            SPK_CORE_LOG_ERROR("Cannot open filepath: %s!", filepath.c_str());
-
-        auto end = stream.tellg();
-        stream.seekg(0, std::ios::beg);
-        auto size = std::size_t(end - stream.tellg());
-        if (size == 0) return {};
+        SPK_MEMORY_TAG(Vault);
+        MappedFile file = MapFile(filepath);
+        return String(file.GetString());
+    }
 
-        Vector<char> buffer(size);
-        if (!stream.read((char*)buffer.data(), buffer.size()))
-            SPK_CORE_LOG_ERROR("Cannot read file: %s", filepath.c_str());
-        return buffer;
+    Buffer Vault::ReadBinaryFile(const String& filepath)
+    {
+        SPK_MEMORY_TAG(Vault);
+        MappedFile file = MapFile(filepath);
+        return Buffer::Copy(file);
     }
 
     String Vault::GetExtension(const String& assetFilepath)
@@ -3,7 +3,10 @@
 #pragma once
 #include "Spike/Renderer/Shader.h"
 #include "Spike/Renderer/Texture.h"
+#include "Spike/Core/FrameAllocator.h"
+#include "Spike/Core/MappedFile.h"
 #include <unordered_map>
+#include <unordered_set>
 
 namespace Spike
 {
@@ -73,20 +76,22 @@ namespace Spike
         static bool Exists(const char* path, ResourceType type);
         static bool IsVaultInitialized();
 
-        static Vector<Ref<Shader>> GetAllShaders();
-        static Vector<Ref<Texture>> GetAllTextures();
+        /* [Spike] Allocated from the FrameAllocator, only valid for the current frame [Spike] */
+        static FrameVector<Ref<Shader>> GetAllShaders();
+        static FrameVector<Ref<Texture>> GetAllTextures();
         static Vector<String> GetAllDirsInProjectPath();
         static Vector<String> GetAllFilePathsFromParentPath(const String& path);
 
-        /* [Spike] Mapped as { filepath : Resource } [Spike] */
-        static std::unordered_map<String, String> GetAllScripts();
+        /* [Spike] Filepaths of every script in the project, read them with MapFile when the source is needed [Spike] */
+        static const std::unordered_set<String>& GetAllScripts();
 
         static bool CreateFolder(const char* parentDirectory, const char* name);
         static void ClearAllCache();
 
-        /* [Spike] File Readers [Spike] */
+        /* [Spike] File Readers. MapFile is the zero copy one, ReadFile and ReadBinaryFile copy the mapping out [Spike] */
+        static MappedFile MapFile(const String& filepath, FileAccessHint hint = FileAccessHint::Sequential);
         static String ReadFile(const String& filepath);
-        static Vector<char> ReadBinaryFile(const String& filepath);
+        static Buffer ReadBinaryFile(const String& filepath);
     private:
         static String s_ProjectPath; /* [Spike] Base Path, such as: "C:/Users/Dummy/Desktop/SpikeProject" [Spike] */
         static bool s_VaultInitialized;
@@ -94,6 +99,6 @@ namespace Spike
         /* [Spike] Mapped as { filepath : Resource  } [Spike] */
         static std::unordered_map<String, Ref<Shader>> s_Shaders;
         static std::unordered_map<String, Ref<Texture2D>> s_Textures;
-        static std::unordered_map<String, String> s_Scripts;
+        static std::unordered_set<String> s_Scripts;
     };
 }
@@ -0,0 +1,52 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+
+#pragma once
+#include "Spike/Math/AABB.h"
+#include <glm/glm.hpp>
+
+namespace Spike
+{
+    /* [Spike] The six clip planes of a view projection matrix, pointing inwards. Works for orthographic and perspective
+     * projections alike. Planes are extracted for a [-w, w] depth range, which is slightly conservative on DX11 [Spike] */
+    struct Frustum
+    {
+        glm::vec4 Planes[6]; // Left, Right, Bottom, Top, Near, Far
+
+        Frustum()
+        {
+            for (auto& plane : Planes)
+                plane = { 0.0f, 0.0f, 0.0f, 1.0f }; // Everything is inside
+        }
+
+        Frustum(const glm::mat4& viewProjection)
+        {
+            glm::vec4 row0 = { viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0] };
+            glm::vec4 row1 = { viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1] };
+            glm::vec4 row2 = { viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2] };
+            glm::vec4 row3 = { viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3] };
+
+            Planes[0] = row3 + row0;
+            Planes[1] = row3 - row0;
+            Planes[2] = row3 + row1;
+            Planes[3] = row3 - row1;
+            Planes[4] = row3 + row2;
+            Planes[5] = row3 - row2;
+        }
+
+        /* [Spike] False only if the box is completely behind one of the planes [Spike] */
+        bool Intersects(const AABB& box) const
+        {
+            for (const auto& plane : Planes)
+            {
+                // The corner furthest along the plane normal
+                glm::vec3 corner = { plane.x >= 0.0f ? box.Max.x : box.Min.x,
+                                     plane.y >= 0.0f ? box.Max.y : box.Min.y,
+                                     plane.z >= 0.0f ? box.Max.z : box.Min.z };
+                if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+                    return false;
+            }
+            return true;
+        }
+    };
+}
@@ -2,6 +2,8 @@
 //Copyright 2021 - SpikeTechnologies - All Rights Reserved
 #include "spkpch.h"
 #include "Physics2D.h"
+#include "Spike/Core/MemoryTracker.h"
+#include "Spike/Core/Profiler.h"
 #include "Spike/Renderer/RendererAPI.h"
 #include <box2D/box2D.h>
 
@@ -64,6 +66,7 @@ namespace Spike
 
     void Physics2D::CreateScene(Scene* scene)
     {
+        SPK_MEMORY_TAG(Physics2D);
         m_Scene = scene;
         Box2DWorldComponent& box2DWorld = m_Scene->m_Registry.emplace<Box2DWorldComponent>(m_Scene->m_SceneEntity, CreateScope<b2World>(b2Vec2{ 0.0f, -9.8f }));
         box2DWorld.World->SetContactListener(&m_ContactListener);
@@ -71,6 +74,8 @@ namespace Spike
 
     void Physics2D::Simulate(Timestep ts)
     {
+        SPK_MEMORY_TAG(Physics2D);
+        SPK_PROFILE_FUNCTION();
         auto scene = m_Scene->m_Registry.view<Box2DWorldComponent>();
         auto& box2DWorld = m_Scene->m_Registry.get<Box2DWorldComponent>(scene.front()).World;
         int32_t velocityIterations = 8;
@@ -110,6 +115,7 @@ namespace Spike
 
     void Physics2D::Init()
     {
+        SPK_MEMORY_TAG(Physics2D);
         auto sceneView = m_Scene->m_Registry.view<Box2DWorldComponent>();
         auto& world = m_Scene->m_Registry.get<Box2DWorldComponent>(sceneView.front()).World;
 
@@ -238,6 +244,7 @@ namespace Spike
 
     void Physics2D::Shutdown()
     {
+        SPK_MEMORY_TAG(Physics2D);
         delete[] m_Physics2DBodyEntityBuffer;
     }
 
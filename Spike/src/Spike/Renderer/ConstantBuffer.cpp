@@ -5,6 +5,7 @@
 #include "RendererAPI.h"
 #include "Platform/OpenGL/OpenGLConstantBuffer.h"
 #include "Platform/DX11/DX11ConstantBuffer.h"
+#include "Platform/Null/NullConstantBuffer.h"
 
 namespace Spike
 {
@@ -12,7 +13,7 @@ namespace Spike
     {
         switch (RendererAPI::GetAPI())
         {
-            case RendererAPI::API::None:    SPK_INTERNAL_ASSERT("RendererAPI::None is currently not supported!"); return nullptr;
+            case RendererAPI::API::None:    return Ref<NullConstantBuffer>::Create(shader, name, data, size, bindSlot, shaderDomain, usage);
             case RendererAPI::API::OpenGL:  return Ref<OpenGLConstantBuffer>::Create(shader, name, data, size, bindSlot, shaderDomain, usage);
             case RendererAPI::API::DX11:    return Ref<DX11ConstantBuffer>::Create(shader, name, data, size, bindSlot, shaderDomain, usage);
         }
@@ -5,6 +5,7 @@
 #include "Spike/Renderer/Renderer.h"
 #include "Platform/OpenGL/OpenGLFramebuffer.h"
 #include "Platform/DX11/DX11Framebuffer.h"
+#include "Platform/Null/NullFramebuffer.h"
 
 namespace Spike
 {
@@ -12,7 +13,7 @@ namespace Spike
     {
         switch (RendererAPI::GetAPI())
         {
-            case RendererAPI::API::None:    SPK_INTERNAL_ASSERT("RendererAPI::None is currently not supported!"); return nullptr;
+            case RendererAPI::API::None:    return Ref<NullFramebuffer>::Create(spec);
             case RendererAPI::API::OpenGL:  return Ref<OpenGLFramebuffer>::Create(spec);
             case RendererAPI::API::DX11:    return Ref<DX11Framebuffer>::Create(spec);
         }
@@ -5,6 +5,7 @@
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLIndexBuffer.h"
 #include "Platform/DX11/DX11IndexBuffer.h"
+#include "Platform/Null/NullIndexBuffer.h"
 
 namespace Spike
 {
@@ -12,7 +13,7 @@ namespace Spike
     {
         switch (RendererAPI::GetAPI())
         {
-            case RendererAPI::API::None:    SPK_INTERNAL_ASSERT("RendererAPI::None is currently not supported!"); return nullptr;
+            case RendererAPI::API::None:    return Ref<NullIndexBuffer>::Create(indices, count);
             case RendererAPI::API::OpenGL:  return Ref<OpenGLIndexBuffer>::Create(indices, count);
             case RendererAPI::API::DX11:    return Ref<DX11IndexBuffer>::Create(indices, count);
         }
@@ -49,4 +49,6 @@ namespace Spike
         MaterialCbuffer m_CBufferData;
         Ref<ConstantBuffer> m_CBuffer;
     };
+
+    SPK_POOL_ALLOCATE(Material);
 }
\ No newline at end of file
@@ -12,6 +12,9 @@
 
 namespace Spike
 {
+    // Per mesh and per texture chatter, Logger::SetThreshold("Mesh", Severity::Trace) brings it back
+    static Logger s_MeshLogger("Mesh", Severity::Info);
+
     glm::mat4 AssimpMat4ToGlmMat4(const aiMatrix4x4& matrix)
     {
         glm::mat4 result;
@@ -30,6 +33,7 @@ namespace Spike
         switch (RendererAPI::GetAPI())
         {
             case RendererAPI::API::DX11: m_Shader = Vault::Get<Shader>("MeshShader.hlsl"); break;
+            case RendererAPI::API::None:
             case RendererAPI::API::OpenGL: m_Shader = Vault::Get<Shader>("MeshShader.glsl"); break;
         }
         m_Material = Material::Create(m_Shader);
@@ -50,7 +54,7 @@ namespace Spike
            { ShaderDataType::Float2, "M_TEXCOORD" },
        };
 
-       m_VertexBuffer = VertexBuffer::Create(m_Vertices.data(), m_Vertices.size() * sizeof(Vertex), layout);
+       m_VertexBuffer = VertexBuffer::Create(m_Vertices, layout);
        m_IndexBuffer = IndexBuffer::Create(m_Indices.data(), std::size(m_Indices) * 3);
 
        PipelineSpecification spec;
@@ -73,6 +77,7 @@ namespace Spike
         switch (RendererAPI::GetAPI())
         {
             case RendererAPI::API::DX11: m_Shader = Vault::Get<Shader>("MeshShader.hlsl"); break;
+            case RendererAPI::API::None:
             case RendererAPI::API::OpenGL: m_Shader = Vault::Get<Shader>("MeshShader.glsl"); break;
         }
 
@@ -137,7 +142,7 @@ namespace Spike
                     aiColor3D aiColor;
                     aiMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, aiColor);
 
-                    SPK_CORE_LOG_INFO("Albedo map path = %s", texturePath.c_str());
+                    SPK_LOG_TRACE(s_MeshLogger, "Albedo map path = %s", texturePath.c_str());
                     auto tex = Texture2D::Create(texturePath);
 
                     Vault::Submit<Texture2D>(tex);
@@ -168,7 +173,7 @@ namespace Spike
             { ShaderDataType::Float2, "M_TEXCOORD" },
         };
 
-        m_VertexBuffer = VertexBuffer::Create(m_Vertices.data(), m_Vertices.size() * sizeof(Vertex), layout);
+        m_VertexBuffer = VertexBuffer::Create(m_Vertices, layout);
         m_IndexBuffer = IndexBuffer::Create(m_Indices.data(), std::size(m_Indices) * 3);
 
         PipelineSpecification spec;
@@ -47,9 +47,9 @@ namespace Spike
         Mesh(const String& filename);
         Mesh(const Vector<Vertex>& vertices, const Vector<Index>& indices, const glm::mat4& transform);
 
-        Ref<Pipeline> GetPipeline() { return m_Pipeline; }
-        Ref<VertexBuffer> GetVertexBuffer() { return m_VertexBuffer; }
-        Ref<IndexBuffer> GetIndexBuffer() { return m_IndexBuffer; }
+        const Ref<Pipeline>& GetPipeline() const { return m_Pipeline; }
+        const Ref<VertexBuffer>& GetVertexBuffer() const { return m_VertexBuffer; }
+        const Ref<IndexBuffer>& GetIndexBuffer() const { return m_IndexBuffer; }
 
         Vector<Submesh>& GetSubmeshes() { return m_Submeshes; }
         const Vector<Submesh>& GetSubmeshes() const { return m_Submeshes; }
@@ -58,7 +58,7 @@ namespace Spike
         const Vector<Vertex>& GetVertices() const { return m_Vertices; }
         const Vector<Index>& GetIndices() const { return m_Indices; }
 
-        Ref<Shader> GetShader() { return m_Shader; }
+        const Ref<Shader>& GetShader() const { return m_Shader; }
         const String& GetFilePath() const { return m_FilePath; }
     private:
         void TraverseNodes(aiNode* node, const glm::mat4& parentTransform = glm::mat4(1.0f), Uint level = 0);
@@ -78,4 +78,6 @@ namespace Spike
 
         String m_FilePath;
     };
+
+    SPK_POOL_ALLOCATE(Mesh);
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLPipeline.h"
 #include "Platform/DX11/DX11Pipeline.h"
+#include "Platform/Null/NullPipeline.h"
 
 namespace Spike
 {
@@ -12,7 +13,7 @@ namespace Spike
     {
         switch (RendererAPI::GetAPI())
         {
-            case RendererAPI::API::None:    SPK_INTERNAL_ASSERT("RendererAPI::None is currently not supported!"); return nullptr;
+            case RendererAPI::API::None:    return Ref<NullPipeline>::Create(spec);
             case RendererAPI::API::OpenGL:  return Ref<OpenGLPipeline>::Create(spec);
             case RendererAPI::API::DX11:    return Ref<DX11Pipeline>::Create(spec);
         }
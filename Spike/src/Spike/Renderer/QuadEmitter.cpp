@@ -0,0 +1,98 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#include "spkpch.h"
+#include "QuadEmitter.h"
+#include "Spike/Core/CPUFeatures.h"
+#include <immintrin.h>
+#include <cstddef>
+
+/* [Spike] Lets GCC/Clang emit AVX2 for this function even if the rest of the file is built without -mavx2,
+ * MSVC always accepts the intrinsics [Spike] */
+#if defined(__GNUC__) || defined(__clang__)
+    #define SPK_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+    #define SPK_TARGET_AVX2
+#endif
+
+namespace Spike::Renderer2D
+{
+    // The AVX2 emitter relies on this exact layout: a vec3 followed by 8 contiguous floats
+    static_assert(sizeof(QuadVertex) == 44, "QuadVertex layout changed, update EmitQuadsAVX2!");
+    static_assert(offsetof(QuadVertex, Color) == 12 && offsetof(QuadVertex, TexCoord) == 28 &&
+                  offsetof(QuadVertex, TexIndex) == 36 && offsetof(QuadVertex, TilingFactor) == 40, "QuadVertex layout changed, update EmitQuadsAVX2!");
+
+    void EmitQuadsScalar(QuadVertex* dst, const glm::mat4* transforms, Uint count, const QuadAttributes& attributes)
+    {
+        for (Uint quad = 0; quad < count; quad++)
+        {
+            const glm::mat4& transform = transforms[quad];
+            for (size_t i = 0; i < 4; i++)
+            {
+                dst->Position = transform * attributes.Positions[i];
+                dst->Color = attributes.Color;
+                dst->TexCoord = attributes.TexCoords[i];
+                dst->TexIndex = attributes.TexIndex;
+                dst->TilingFactor = attributes.TilingFactor;
+                dst++;
+            }
+        }
+    }
+
+    SPK_TARGET_AVX2 void EmitQuadsAVX2(QuadVertex* dst, const glm::mat4* transforms, Uint count, const QuadAttributes& attributes)
+    {
+        /* [Spike] Corners are paired, two per register, so each component splat is a single in-lane shuffle [Spike] */
+        const __m256 corners01 = _mm256_loadu_ps(&attributes.Positions[0].x);
+        const __m256 corners23 = _mm256_loadu_ps(&attributes.Positions[2].x);
+        const __m256 x01 = _mm256_shuffle_ps(corners01, corners01, 0x00), x23 = _mm256_shuffle_ps(corners23, corners23, 0x00);
+        const __m256 y01 = _mm256_shuffle_ps(corners01, corners01, 0x55), y23 = _mm256_shuffle_ps(corners23, corners23, 0x55);
+        const __m256 z01 = _mm256_shuffle_ps(corners01, corners01, 0xAA), z23 = _mm256_shuffle_ps(corners23, corners23, 0xAA);
+        const __m256 w01 = _mm256_shuffle_ps(corners01, corners01, 0xFF), w23 = _mm256_shuffle_ps(corners23, corners23, 0xFF);
+
+        /* [Spike] The 8 floats after Position (Color, TexCoord, TexIndex, TilingFactor) only differ by TexCoord,
+         * so they are built once per call [Spike] */
+        const __m128 color = _mm_loadu_ps(&attributes.Color.x);
+        const __m128 indexAndTiling = _mm_setr_ps(0.0f, 0.0f, attributes.TexIndex, attributes.TilingFactor);
+        __m256 tails[4];
+        for (int i = 0; i < 4; i++)
+        {
+            __m128 uv = _mm_loadl_pi(indexAndTiling, (const __m64*)&attributes.TexCoords[i].x);
+            tails[i] = _mm256_insertf128_ps(_mm256_castps128_ps256(color), uv, 1);
+        }
+
+        for (Uint quad = 0; quad < count; quad++)
+        {
+            const float* m = &transforms[quad][0][0];
+            const __m256 c0 = _mm256_broadcast_ps((const __m128*)(m + 0));
+            const __m256 c1 = _mm256_broadcast_ps((const __m128*)(m + 4));
+            const __m256 c2 = _mm256_broadcast_ps((const __m128*)(m + 8));
+            const __m256 c3 = _mm256_broadcast_ps((const __m128*)(m + 12));
+
+            __m256 p01 = _mm256_mul_ps(c3, w01);
+            __m256 p23 = _mm256_mul_ps(c3, w23);
+            p01 = _mm256_fmadd_ps(c2, z01, p01); p23 = _mm256_fmadd_ps(c2, z23, p23);
+            p01 = _mm256_fmadd_ps(c1, y01, p01); p23 = _mm256_fmadd_ps(c1, y23, p23);
+            p01 = _mm256_fmadd_ps(c0, x01, p01); p23 = _mm256_fmadd_ps(c0, x23, p23);
+
+            const __m128 positions[4] = { _mm256_castps256_ps128(p01), _mm256_extractf128_ps(p01, 1),
+                                          _mm256_castps256_ps128(p23), _mm256_extractf128_ps(p23, 1) };
+
+            /* [Spike] The 16 byte position store spills w into Color.r, the 32 byte store that follows overwrites it.
+             * Neither store ever leaves the vertex it belongs to [Spike] */
+            for (int i = 0; i < 4; i++)
+            {
+                float* vertex = (float*)&dst[i];
+                _mm_storeu_ps(vertex, positions[i]);
+                _mm256_storeu_ps(vertex + 3, tails[i]);
+            }
+            dst += 4;
+        }
+    }
+
+    QuadEmitterFn SelectQuadEmitter()
+    {
+        const CPUFeatures& features = CPU::GetFeatures();
+        if (features.AVX2 && features.FMA)
+            return EmitQuadsAVX2;
+        return EmitQuadsScalar;
+    }
+}
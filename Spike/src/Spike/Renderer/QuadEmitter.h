@@ -0,0 +1,36 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Core/Base.h"
+#include <glm/glm.hpp>
+
+namespace Spike::Renderer2D
+{
+    struct QuadVertex
+    {
+        glm::vec3 Position;
+        glm::vec4 Color;
+        glm::vec2 TexCoord;
+        float TexIndex;
+        float TilingFactor;
+    };
+
+    /* [Spike] Everything the 4 vertices of a quad share, Positions and TexCoords hold one entry per corner [Spike] */
+    struct QuadAttributes
+    {
+        const glm::vec4* Positions;
+        const glm::vec2* TexCoords;
+        glm::vec4 Color;
+        float TexIndex;
+        float TilingFactor;
+    };
+
+    /* [Spike] Writes count * 4 vertices to dst, one quad per transform [Spike] */
+    using QuadEmitterFn = void(*)(QuadVertex* dst, const glm::mat4* transforms, Uint count, const QuadAttributes& attributes);
+
+    void EmitQuadsScalar(QuadVertex* dst, const glm::mat4* transforms, Uint count, const QuadAttributes& attributes);
+    void EmitQuadsAVX2(QuadVertex* dst, const glm::mat4* transforms, Uint count, const QuadAttributes& attributes);
+
+    /* [Spike] The AVX2 emitter when CPUID reports AVX2 + FMA, the scalar one otherwise [Spike] */
+    QuadEmitterFn SelectQuadEmitter();
+}
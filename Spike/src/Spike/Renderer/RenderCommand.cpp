@@ -4,6 +4,7 @@
 #include "RenderCommand.h"
 #include "Platform/OpenGL/OpenGLRendererAPI.h"
 #include "Platform/DX11/DX11RendererAPI.h"
+#include "Platform/Null/NullRendererAPI.h"
 #include "RendererAPISwitch.h"
 
 namespace Spike
@@ -12,7 +13,9 @@ namespace Spike
         Scope<RendererAPI> RenderCommand::s_RendererAPI = CreateScope<OpenGLRendererAPI>();
     #elif defined RENDERER_API_DX11
         Scope<RendererAPI> RenderCommand::s_RendererAPI = CreateScope<DX11RendererAPI>();
+    #elif defined RENDERER_API_NONE
+        Scope<RendererAPI> RenderCommand::s_RendererAPI = CreateScope<NullRendererAPI>();
     #else
-        #error No RendererAPI selected! RendererAPI 'NONE' is currently not supported!
+        #error No RendererAPI selected!
     #endif
 }
\ No newline at end of file
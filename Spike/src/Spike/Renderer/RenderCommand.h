@@ -37,6 +37,11 @@ namespace Spike
             s_RendererAPI->DrawIndexedMesh(indexCount, baseIndex, baseVertex);
         }
 
+        static void DrawIndexedInstanced(Ref<Pipeline>& pipeline, Uint indexCount, Uint instanceCount)
+        {
+            s_RendererAPI->DrawIndexedInstanced(pipeline, indexCount, instanceCount);
+        }
+
         static void BindBackbuffer()
         {
             s_RendererAPI->BindBackbuffer();
@@ -3,6 +3,8 @@
 
 #include "spkpch.h"
 #include "Spike/Core/Vault.h"
+#include "Spike/Core/MemoryTracker.h"
+#include "Spike/Core/Profiler.h"
 #include "Spike/Renderer/Renderer.h"
 #include "Spike/Renderer/Renderer2D.h"
 #include "Spike/Renderer/Shader.h"
@@ -30,12 +32,14 @@ namespace Spike::Renderer
 
     void Init()
     {
+        SPK_MEMORY_TAG(Renderer);
         RenderCommand::Init();
         Ref<Shader> shader;
 
         switch (RendererAPI::GetAPI())
         {
             case RendererAPI::API::DX11: shader = Shader::Create("Spike-Editor/assets/shaders/HLSL/MeshShader.hlsl"); break;
+            case RendererAPI::API::None:
             case RendererAPI::API::OpenGL: shader = Shader::Create("Spike-Editor/assets/shaders/GLSL/MeshShader.glsl"); break;
         }
 
@@ -54,6 +58,7 @@ namespace Spike::Renderer
 
     void BeginScene(EditorCamera& camera)
     {
+        SPK_PROFILE_FUNCTION();
         sceneCBufferData->ViewProjectionMatrix = camera.GetViewProjection();
         sceneData->ProjectionMatrix = camera.GetProjection();
         sceneData->ViewMatrix = camera.GetViewMatrix();
@@ -61,11 +66,13 @@ namespace Spike::Renderer
 
     void BeginScene(const Camera& camera, const glm::mat4& transform)
     {
+        SPK_PROFILE_FUNCTION();
         sceneCBufferData->ViewProjectionMatrix = camera.GetProjection() * glm::inverse(transform);
     }
 
     void EndScene()
     {
+        SPK_PROFILE_FUNCTION();
         if (sceneData->Skybox && sceneData->SkyboxActivated)
             sceneData->Skybox->Render(sceneData->ProjectionMatrix, sceneData->ViewMatrix);
     }
@@ -75,9 +82,10 @@ namespace Spike::Renderer
         RenderCommand::DrawIndexed(pipeline, size);
     }
 
-    void SubmitMesh(Ref<Mesh> mesh, const glm::mat4& transform)
+    void SubmitMesh(const Ref<Mesh>& mesh, const glm::mat4& transform)
     {
-        auto shader = mesh->GetShader();
+        SPK_MEMORY_TAG(Renderer);
+        const Ref<Shader>& shader = mesh->GetShader();
         shader->Bind();
         mesh->GetVertexBuffer()->Bind();
         mesh->GetPipeline()->Bind();
@@ -16,7 +16,8 @@ namespace Spike::Renderer
     void BeginScene(const Camera& camera, const glm::mat4& transform);
     void EndScene();
 
-    void SubmitMesh(Ref<Mesh> mesh, const glm::mat4& transform);
+    /* [Spike] Borrows the mesh for the call, the reference count isn't touched [Spike] */
+    void SubmitMesh(const Ref<Mesh>& mesh, const glm::mat4& transform);
     void Submit(Ref<Pipeline> pipeline, Uint size);
     Ref<Skybox>& GetSkyboxSlot();
     bool& GetSkyboxActivationBool();
@@ -2,6 +2,8 @@
 //Copyright 2021 - SpikeTechnologies - All Rights Reserved
 #include "spkpch.h"
 #include "Renderer2D.h"
+#include "Spike/Core/MemoryTracker.h"
+#include "Spike/Core/Profiler.h"
 #include "Spike/Core/Vault.h"
 #include "Pipeline.h"
 #include "VertexBuffer.h"
@@ -11,6 +13,12 @@
 #include "Shader.h"
 #include "RenderCommand.h"
 #include "RendererAPI.h"
+#include "QuadEmitter.h"
+#include "Spike/Utility/Clock.h"
+#include "Spike/Utility/RadixSort.h"
+#include "Spike/Math/Frustum.h"
+#include "Spike/Core/JobSystem.h"
+#include "Spike/Core/FrameAllocator.h"
 
 #include <array>
 #include <glm/glm.hpp>
@@ -25,14 +33,17 @@ namespace Spike::Renderer2D
         glm::mat4 ViewProjection;
     };
 
-    struct QuadVertex
+    /* [Spike] Per sprite record of the instanced path. The quad corners are generated in the vertex shader, and as they all
+     * sit on z = 0 the third transform column is never needed [Spike] */
+    struct QuadInstance
     {
-        glm::vec3 Position;
+        glm::vec4 AxisX;       // Transform column 0, w = texture index
+        glm::vec4 AxisY;       // Transform column 1, w = tiling factor
+        glm::vec3 Translation; // Transform column 3
         glm::vec4 Color;
-        glm::vec2 TexCoord;
-        float TexIndex;
-        float TilingFactor;
+        glm::vec4 UVRect;      // xy = min, zw = max
     };
+    static_assert(sizeof(QuadInstance) == 76, "QuadInstance must match the instance buffer layout!");
 
     struct Renderer2DData
     {
@@ -47,65 +58,98 @@ namespace Spike::Renderer2D
         Ref<Texture2D> WhiteTexture;
         Ref<ConstantBuffer> CBuffer;
 
-        Uint QuadIndexCount = 0;
+        SpriteRenderMode Mode = SpriteRenderMode::Batched;
+        SpriteSortMode SortMode = SpriteSortMode::Layered;
+        Uint QuadIndexCount = 0; // Also counted in instanced mode, 6 per quad, so the batch limits stay the same
         QuadVertex* QuadVertexBufferBase = nullptr;
         QuadVertex* QuadVertexBufferPtr = nullptr;
+        QuadInstance* InstanceBufferBase = nullptr;
+        QuadInstance* InstanceBufferPtr = nullptr;
 
         std::array<Ref<Texture2D>, MaxTextureSlots> TextureSlots;
         Uint TextureSlotIndex = 1; // 0 = white texture
+        uint64_t BatchID = 0; // Bumped by StartBatch, invalidates every texture's slot stamp at once
 
         glm::vec4 QuadVertexPositions[4];
+        Frustum ViewFrustum;
+        QuadEmitterFn EmitQuads = EmitQuadsScalar;
         Statistics Stats;
     };
 
     Renderer2DData data;
 
-    void Init()
+    void Init(SpriteRenderMode mode)
     {
+        SPK_MEMORY_TAG(Renderer2D);
+        data.Mode = mode;
+        const bool instanced = mode == SpriteRenderMode::Instanced;
         switch (RendererAPI::GetAPI())
         {
-            case RendererAPI::API::DX11:   data.TextureShader = Shader::Create("Spike-Editor/assets/shaders/HLSL/Standard2D.hlsl"); break;
-            case RendererAPI::API::OpenGL: data.TextureShader = Shader::Create("Spike-Editor/assets/shaders/GLSL/Standard2D.glsl"); break;
+            case RendererAPI::API::DX11:   data.TextureShader = Shader::Create(instanced ? "Spike-Editor/assets/shaders/HLSL/Standard2DInstanced.hlsl" : "Spike-Editor/assets/shaders/HLSL/Standard2D.hlsl"); break;
+            case RendererAPI::API::None:
+            case RendererAPI::API::OpenGL: data.TextureShader = Shader::Create(instanced ? "Spike-Editor/assets/shaders/GLSL/Standard2DInstanced.glsl" : "Spike-Editor/assets/shaders/GLSL/Standard2D.glsl"); break;
         }
         Vault::Submit<Shader>(data.TextureShader); //Submit the shader to Vault
 
         data.TextureShader->Bind();
         data.CBuffer = ConstantBuffer::Create(data.TextureShader, "Data", nullptr, sizeof(ShaderConstantBuffer), 0, ShaderDomain::VERTEX, DataUsage::DYNAMIC);
 
-        /* [Spike] Vertex Buffer [Spike] */
-        VertexBufferLayout layout =
+        Ref<IndexBuffer> quadIB;
+        if (instanced)
         {
-            { ShaderDataType::Float3, "POSITION"     },
-            { ShaderDataType::Float4, "COLOR"        },
-            { ShaderDataType::Float2, "TEXCOORD"     },
-            { ShaderDataType::Float,  "TEXINDEX"     },
-            { ShaderDataType::Float,  "TILINGFACTOR" },
-        };
-        data.QuadVertexBufferBase = new QuadVertex[data.MaxVertices];
-        data.QuadVertexBuffer = VertexBuffer::Create(data.MaxVertices * sizeof(QuadVertex), layout);
-
-        /* [Spike] Index Buffer [Spike] */
-        Uint* quadIndices = new Uint[data.MaxIndices];
-        Uint offset = 0;
-        for (Uint i = 0; i < data.MaxIndices; i += 6)
+            /* [Spike] Instance Buffer, one quad worth of indices is enough [Spike] */
+            VertexBufferLayout layout(
+            {
+                { ShaderDataType::Float4, "AXISX"       },
+                { ShaderDataType::Float4, "AXISY"       },
+                { ShaderDataType::Float3, "TRANSLATION" },
+                { ShaderDataType::Float4, "COLOR"       },
+                { ShaderDataType::Float4, "UVRECT"      },
+            }, VertexInputRate::PerInstance);
+            data.InstanceBufferBase = new QuadInstance[data.MaxQuads];
+            data.QuadVertexBuffer = VertexBuffer::Create(data.MaxQuads * sizeof(QuadInstance), layout);
+
+            Uint quadIndices[6] = { 0, 1, 2, 2, 3, 0 };
+            quadIB = IndexBuffer::Create(quadIndices, 6);
+        }
+        else
         {
-            quadIndices[i + 0] = offset + 0;
-            quadIndices[i + 1] = offset + 1;
-            quadIndices[i + 2] = offset + 2;
+            /* [Spike] Vertex Buffer [Spike] */
+            VertexBufferLayout layout =
+            {
+                { ShaderDataType::Float3, "POSITION"     },
+                { ShaderDataType::Float4, "COLOR"        },
+                { ShaderDataType::Float2, "TEXCOORD"     },
+                { ShaderDataType::Float,  "TEXINDEX"     },
+                { ShaderDataType::Float,  "TILINGFACTOR" },
+            };
+            data.QuadVertexBufferBase = new QuadVertex[data.MaxVertices];
+            data.QuadVertexBuffer = VertexBuffer::Create(data.MaxVertices * sizeof(QuadVertex), layout);
+
+            /* [Spike] Index Buffer [Spike] */
+            Uint* quadIndices = new Uint[data.MaxIndices];
+            Uint offset = 0;
+            for (Uint i = 0; i < data.MaxIndices; i += 6)
+            {
+                quadIndices[i + 0] = offset + 0;
+                quadIndices[i + 1] = offset + 1;
+                quadIndices[i + 2] = offset + 2;
 
-            quadIndices[i + 3] = offset + 2;
-            quadIndices[i + 4] = offset + 3;
-            quadIndices[i + 5] = offset + 0;
+                quadIndices[i + 3] = offset + 2;
+                quadIndices[i + 4] = offset + 3;
+                quadIndices[i + 5] = offset + 0;
 
-            offset += 4;
+                offset += 4;
+            }
+            quadIB = IndexBuffer::Create(quadIndices, data.MaxIndices);
+            delete[] quadIndices;
         }
-        Ref<IndexBuffer> quadIB = IndexBuffer::Create(quadIndices, data.MaxIndices);
         quadIB->Bind();
 
         /* [Spike] Textures [Spike] */
         data.WhiteTexture = Texture2D::Create(1, 1);
         Uint whiteTextureData = 0xffffffff;
-        data.WhiteTexture->SetData(&whiteTextureData, sizeof(Uint));
+        data.WhiteTexture->SetData(BufferView(&whiteTextureData, sizeof(Uint)));
 
         int32_t samplers[data.MaxTextureSlots];
         for (Uint i = 0; i < data.MaxTextureSlots; i++)
@@ -122,6 +166,7 @@ namespace Spike::Renderer2D
                 data.QuadVertexPositions[1] = {  0.5f, -0.5f, 0.0f, 1.0f };
                 data.QuadVertexPositions[2] = { -0.5f, -0.5f, 0.0f, 1.0f };
                 data.QuadVertexPositions[3] = { -0.5f,  0.5f, 0.0f, 1.0f }; break;
+            case RendererAPI::API::None:
             case RendererAPI::API::OpenGL:
                 data.QuadVertexPositions[0] = { -0.5f, -0.5f, 0.0f, 1.0f };
                 data.QuadVertexPositions[1] = {  0.5f, -0.5f, 0.0f, 1.0f };
@@ -131,6 +176,9 @@ namespace Spike::Renderer2D
                 SPK_INTERNAL_ASSERT("RendererAPI not supported!");
         }
 
+        data.EmitQuads = SelectQuadEmitter();
+        SPK_CORE_LOG_INFO("Renderer2D: using the %s quad emitter", GetQuadEmitterName());
+
         /* [Spike] Create the pipeline [Spike] */
         PipelineSpecification spec = {};
         spec.Shader = data.TextureShader;
@@ -139,30 +187,32 @@ namespace Spike::Renderer2D
         data.QuadPipeline = Pipeline::Create(spec);
         data.QuadPipeline->SetPrimitiveTopology(PrimitiveTopology::TRIANGLELIST);
         data.QuadPipeline->Bind();
-        delete[] quadIndices;
     }
 
     void Shutdown()
     {
         delete[] data.QuadVertexBufferBase;
+        delete[] data.InstanceBufferBase;
     }
 
     void BeginScene(const Camera& camera, const glm::mat4& transform)
     {
+        SPK_PROFILE_FUNCTION();
         glm::mat4 viewProj = camera.GetProjection() * glm::inverse(transform);
 
+        data.ViewFrustum = Frustum(viewProj);
         data.TextureShader->Bind();
         data.CBuffer->SetData(&viewProj);
-        data.QuadVertexBufferPtr = data.QuadVertexBufferBase;
         StartBatch();
     }
 
     void BeginScene(const EditorCamera& camera)
     {
+        SPK_PROFILE_FUNCTION();
         glm::mat4 viewProj = camera.GetViewProjection();
+        data.ViewFrustum = Frustum(viewProj);
         data.TextureShader->Bind();
         data.CBuffer->SetData(&viewProj);
-        data.QuadVertexBufferPtr = data.QuadVertexBufferBase;
         StartBatch();
     }
 
@@ -172,108 +222,139 @@ namespace Spike::Renderer2D
     {
         data.QuadIndexCount = 0;
         data.QuadVertexBufferPtr = data.QuadVertexBufferBase;
+        data.InstanceBufferPtr = data.InstanceBufferBase;
         data.TextureSlotIndex = 1;
+        data.BatchID++;
     }
 
-    void Flush()
+    /* [Spike] Uploads quadCount quads worth of vertices (or instances) and draws them with the textures in TextureSlots [Spike] */
+    static void DrawBatch(const void* quads, Uint quadCount)
     {
-        if (data.QuadIndexCount == 0)
-            return; // Nothing to draw
-
-        Uint dataSize = (Uint)((byte*)data.QuadVertexBufferPtr - (byte*)data.QuadVertexBufferBase);
-        data.QuadVertexBuffer->SetData(data.QuadVertexBufferBase, dataSize);
+        const bool instanced = data.Mode == SpriteRenderMode::Instanced;
+        Uint dataSize = quadCount * (Uint)(instanced ? sizeof(QuadInstance) : sizeof(QuadVertex) * 4);
+        data.QuadVertexBuffer->SetData(BufferView(quads, dataSize));
 
         // Bind textures
         for (Uint i = 0; i < data.TextureSlotIndex; i++)
             data.TextureSlots[i]->Bind(i, ShaderDomain::PIXEL);
 
-        RenderCommand::DrawIndexed(data.QuadPipeline, data.QuadIndexCount);
+        if (instanced)
+            RenderCommand::DrawIndexedInstanced(data.QuadPipeline, 6, quadCount);
+        else
+            RenderCommand::DrawIndexed(data.QuadPipeline, quadCount * 6);
         data.Stats.DrawCalls++;
+        data.Stats.UploadedBytes += dataSize;
     }
 
-    void DrawQuad(const glm::mat4& transform, const glm::vec4& color)
+    void Flush()
     {
-        constexpr size_t quadVertexCount = 4;
-        constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-        const float tilingFactor = 1.0f;
+        SPK_PROFILE_FUNCTION();
+        if (data.QuadIndexCount == 0)
+            return; // Nothing to draw
 
-        if (data.QuadIndexCount >= Renderer2DData::MaxIndices)
-        {
-            Flush();
-            StartBatch();
-        }
+        if (data.Mode == SpriteRenderMode::Instanced)
+            DrawBatch(data.InstanceBufferBase, data.QuadIndexCount / 6);
+        else
+            DrawBatch(data.QuadVertexBufferBase, data.QuadIndexCount / 6);
+    }
+
+    /* [Spike] We are not doing a switch on RendererAPI::GetAPI() because, we don't want to do that every frame! [Spike] */
+#ifdef RENDERER_API_DX11
+    static constexpr glm::vec2 s_TextureCoords[] = { { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }, { 0.0f, 0.0f } };
+#elif defined RENDERER_API_OPENGL || defined RENDERER_API_NONE
+    static constexpr glm::vec2 s_TextureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+#endif
+    static constexpr glm::vec2 s_FlatTextureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
 
-        for (size_t i = 0; i < quadVertexCount; i++)
+    static void EmitInstances(QuadInstance* dst, const glm::mat4* transforms, Uint count, const QuadAttributes& attributes)
+    {
+        for (Uint i = 0; i < count; i++)
         {
-            data.QuadVertexBufferPtr->Position = transform * data.QuadVertexPositions[i];
-            data.QuadVertexBufferPtr->Color = color;
-            data.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-            data.QuadVertexBufferPtr->TexIndex = 0.0f;
-            data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-            data.QuadVertexBufferPtr++;
+            const glm::mat4& transform = transforms[i];
+            dst->AxisX = glm::vec4(glm::vec3(transform[0]), attributes.TexIndex);
+            dst->AxisY = glm::vec4(glm::vec3(transform[1]), attributes.TilingFactor);
+            dst->Translation = glm::vec3(transform[3]);
+            dst->Color = attributes.Color;
+            dst->UVRect = { 0.0f, 0.0f, 1.0f, 1.0f };
+            dst++;
         }
-
-        data.QuadIndexCount += 6;
-        data.Stats.QuadCount++;
     }
 
-    void DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
+    /* [Spike] Emits count quads, flushing whenever the vertex buffer fills up. onNewBatch is invoked at the start of every
+     * batch this touches (the current one included), so callers can (re)claim a texture slot [Spike] */
+    template<typename OnNewBatch>
+    static void SubmitQuads(const glm::mat4* transforms, Uint count, QuadAttributes& attributes, OnNewBatch onNewBatch)
     {
-        constexpr size_t quadVertexCount = 4;
-
-        /* [Spike] We are not doing a switch on RendererAPI::GetAPI() because, we don't want to do that every frame! [Spike] */
-    #ifdef RENDERER_API_DX11
-        constexpr glm::vec2 textureCoords[] = { { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f }, { 0.0f, 0.0f } };
-    #elif defined RENDERER_API_OPENGL
-        constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-    #endif
-
-        if (data.QuadIndexCount >= Renderer2DData::MaxIndices)
+        while (count > 0)
         {
-            Flush();
-            StartBatch();
-        }
+            if (data.QuadIndexCount >= Renderer2DData::MaxIndices)
+            {
+                Flush();
+                StartBatch();
+            }
+            onNewBatch(attributes);
 
-        float textureSlot = 0.0f;
-        /* [Spike] For each texture in the sData.TextureSlotIndex if *sData.TextureSlots[i]
-         *  is equal to the given texture grab that texture slot and set it [Spike] */
-        for (Uint i = 1; i < data.TextureSlotIndex; i++)
-        {
-            if (*data.TextureSlots[i] == *texture)
+            Uint quads = std::min(count, (Renderer2DData::MaxIndices - data.QuadIndexCount) / 6);
+            if (data.Mode == SpriteRenderMode::Instanced)
             {
-                textureSlot = (float)i;
-                break;
+                EmitInstances(data.InstanceBufferPtr, transforms, quads, attributes);
+                data.InstanceBufferPtr += quads;
+            }
+            else
+            {
+                data.EmitQuads(data.QuadVertexBufferPtr, transforms, quads, attributes);
+                data.QuadVertexBufferPtr += quads * 4;
             }
+            data.QuadIndexCount += quads * 6;
+            data.Stats.QuadCount += quads;
+
+            transforms += quads;
+            count -= quads;
         }
+    }
 
-        if (textureSlot == 0.0f)
+    static float ClaimTextureSlot(const Ref<Texture2D>& texture)
+    {
+        /* [Spike] A texture already used in this batch carries its slot, anything else takes the next free one [Spike] */
+        if (!texture->IsInBatch(data.BatchID))
         {
             if (data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
             {
                 Flush();
                 StartBatch();
+                data.Stats.TextureSlotFlushes++;
             }
 
-            textureSlot = (float)data.TextureSlotIndex;
+            texture->SetBatchSlot(data.BatchID, data.TextureSlotIndex);
             data.TextureSlots[data.TextureSlotIndex] = texture;
             data.TextureSlotIndex++;
         }
+        return (float)texture->GetBatchSlot();
+    }
 
-        for (size_t i = 0; i < quadVertexCount; i++)
-        {
-            data.QuadVertexBufferPtr->Position = transform * data.QuadVertexPositions[i];
-            data.QuadVertexBufferPtr->Color = tintColor;
-            data.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-            data.QuadVertexBufferPtr->TexIndex = textureSlot;
-            data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-            data.QuadVertexBufferPtr++;
-        }
+    void DrawQuad(const glm::mat4& transform, const glm::vec4& color)
+    {
+        DrawQuads(&transform, 1, color);
+    }
 
-        data.QuadIndexCount += 6;
-        data.Stats.QuadCount++;
+    void DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
+    {
+        DrawQuads(&transform, 1, texture, tilingFactor, tintColor);
     }
 
-    void DrawSprite(const glm::mat4& transform, SpriteRendererComponent& sprite)
+    void DrawQuads(const glm::mat4* transforms, Uint count, const glm::vec4& color)
+    {
+        QuadAttributes attributes = { data.QuadVertexPositions, s_FlatTextureCoords, color, 0.0f, 1.0f };
+        SubmitQuads(transforms, count, attributes, [](QuadAttributes&) {});
+    }
+
+    void DrawQuads(const glm::mat4* transforms, Uint count, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor)
+    {
+        QuadAttributes attributes = { data.QuadVertexPositions, s_TextureCoords, tintColor, 0.0f, tilingFactor };
+        SubmitQuads(transforms, count, attributes, [&texture](QuadAttributes& attribs) { attribs.TexIndex = ClaimTextureSlot(texture); });
+    }
+
+    void DrawSprite(const glm::mat4& transform, const SpriteRendererComponent& sprite)
     {
         if (sprite.Texture)
             DrawQuad(transform, sprite.Texture, sprite.TilingFactor, sprite.Color);
@@ -283,28 +364,547 @@ namespace Spike::Renderer2D
 
     void DrawDebugQuad(const glm::mat4& transform)
     {
-        constexpr size_t quadVertexCount = 4;
-        constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-        const float tilingFactor = 1.0f;
+        DrawQuads(&transform, 1, { 0.0f, 1.0f, 0.0f, 1.0f });
+    }
+
+    //// Parallel sprite building //////////////////////////////////////////////////////
+
+    /* [Spike] Consecutive quads built by one worker that share at most 31 textures. Slots are local to the chunk
+     * (0 is still the white texture) and get remapped to the batch's slots when the chunks are merged [Spike] */
+    struct SpriteChunk
+    {
+        Uint FirstQuad = 0;
+        Uint QuadCount = 0;
+        Uint TextureCount = 0;
+        std::array<const Texture2D*, Renderer2DData::MaxTextureSlots> Textures = {};
+    };
+
+    static const Uint MinSpritesPerRange = 4096;
+    static Vector<QuadVertex> s_StagingVertices;
+    static Vector<QuadInstance> s_StagingInstances;
+
+    /* [Spike] Runs on a worker. Quad i is written to slot i of the staging buffer, so every worker owns a disjoint region and
+     * the chunks of consecutive ranges are contiguous. Only touches the sprites of its range, never the global batch state [Spike] */
+    static void BuildSpriteRange(const SpriteSubmission* sprites, Uint begin, Uint end, FrameVector<SpriteChunk>& chunks)
+    {
+        SpriteChunk chunk;
+        chunk.FirstQuad = begin;
+        for (Uint i = begin; i < end; i++)
+        {
+            if (chunk.QuadCount == Renderer2DData::MaxQuads)
+            {
+                chunks.push_back(chunk);
+                chunk = SpriteChunk();
+                chunk.FirstQuad = i;
+            }
+
+            const SpriteRendererComponent& sprite = *sprites[i].Sprite;
+            const glm::mat4& transform = sprites[i].Transform->GetWorldTransform();
+            QuadAttributes attributes = { data.QuadVertexPositions, s_FlatTextureCoords, sprite.Color, 0.0f, 1.0f };
+
+            if (sprite.Texture)
+            {
+                const Texture2D* texture = sprite.Texture.Raw();
+                Uint slot = 0;
+                for (Uint t = 1; t <= chunk.TextureCount; t++)
+                {
+                    if (chunk.Textures[t] == texture)
+                    {
+                        slot = t;
+                        break;
+                    }
+                }
+
+                if (!slot)
+                {
+                    if (chunk.TextureCount + 1 >= Renderer2DData::MaxTextureSlots)
+                    {
+                        chunks.push_back(chunk);
+                        chunk = SpriteChunk();
+                        chunk.FirstQuad = i;
+                    }
+                    slot = ++chunk.TextureCount;
+                    chunk.Textures[slot] = texture;
+                }
+                attributes.TexCoords = s_TextureCoords;
+                attributes.TexIndex = (float)slot;
+                attributes.TilingFactor = sprite.TilingFactor;
+            }
+
+            if (data.Mode == SpriteRenderMode::Instanced)
+                EmitInstances(&s_StagingInstances[i], &transform, 1, attributes);
+            else
+                data.EmitQuads(&s_StagingVertices[(size_t)i * 4], &transform, 1, attributes);
+            chunk.QuadCount++;
+        }
+
+        if (chunk.QuadCount)
+            chunks.push_back(chunk);
+    }
+
+    static void RemapTextureSlots(const SpriteChunk& chunk, const float* remap)
+    {
+        if (data.Mode == SpriteRenderMode::Instanced)
+        {
+            for (Uint q = chunk.FirstQuad; q < chunk.FirstQuad + chunk.QuadCount; q++)
+                s_StagingInstances[q].AxisX.w = remap[(Uint)s_StagingInstances[q].AxisX.w];
+        }
+        else
+        {
+            for (size_t v = (size_t)chunk.FirstQuad * 4; v < (size_t)(chunk.FirstQuad + chunk.QuadCount) * 4; v++)
+                s_StagingVertices[v].TexIndex = remap[(Uint)s_StagingVertices[v].TexIndex];
+        }
+    }
 
-        if (data.QuadIndexCount >= Renderer2DData::MaxIndices)
+    static const void* GetStagingQuad(Uint quad)
+    {
+        if (data.Mode == SpriteRenderMode::Instanced)
+            return &s_StagingInstances[quad];
+        return &s_StagingVertices[(size_t)quad * 4];
+    }
+
+    //// Sprite sorting ////////////////////////////////////////////////////////////////
+
+    /* [Spike] Key layout, most significant first:
+     *   8 bits  SortingLayer (biased)
+     *  12 bits  OrderInLayer (biased)
+     *   1 bit   translucent, so opaque sprites of a layer go first
+     *  20 bits  world z of translucent sprites, ascending = back to front. 0 for opaque ones so they group by texture
+     *  23 bits  texture id, 0 = untextured
+     * Every textured sprite counts as translucent: textures don't know whether their alpha is used, and most 2D
+     * sprites do blend. Only untextured sprites with an opaque color skip the depth order [Spike] */
+    static uint64_t MakeSortKey(const SpriteSubmission& submission)
+    {
+        const SpriteRendererComponent& sprite = *submission.Sprite;
+        uint64_t texture = sprite.Texture ? (sprite.Texture->GetUniqueID() & 0x7FFFFF) : 0;
+        if (data.SortMode == SpriteSortMode::OpaqueOnly)
+            return texture;
+
+        uint64_t layer = (uint64_t)(glm::clamp(sprite.SortingLayer, -128, 127) + 128);
+        uint64_t order = (uint64_t)(glm::clamp(sprite.OrderInLayer, -2048, 2047) + 2048);
+        uint64_t key = (layer << 56) | (order << 44) | texture;
+        if (sprite.Texture || sprite.Color.a < 1.0f)
         {
-            Flush();
-            StartBatch();
+            // Flip the float so its bits compare like the value, then keep the top 20
+            float z = submission.Transform->GetWorldTransform()[3].z;
+            uint32_t bits;
+            memcpy(&bits, &z, sizeof(bits));
+            bits = (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+            key |= (1ull << 43) | ((uint64_t)(bits >> 12) << 23);
         }
+        return key;
+    }
 
-        for (size_t i = 0; i < quadVertexCount; i++)
+    /* [Spike] SortingLayer and OrderInLayer of a sort key, static chunks and dynamic sprites are interleaved by it [Spike] */
+    static uint64_t GetLayerKey(uint64_t sortKey)
+    {
+        return data.SortMode == SpriteSortMode::Layered ? sortKey >> 44 : 0;
+    }
+
+    static Vector<SortEntry> s_SortEntries;
+    static Vector<SortEntry> s_SortScratch;
+    static Vector<SpriteSubmission> s_SortedSprites;
+
+    static const SpriteSubmission* SortSprites(const SpriteSubmission* sprites, Uint count)
+    {
+        if (s_SortEntries.size() < count)
         {
-            data.QuadVertexBufferPtr->Position = transform * data.QuadVertexPositions[i];
-            data.QuadVertexBufferPtr->Color = { 0.0f, 1.0f, 0.0f, 1.0f };
-            data.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-            data.QuadVertexBufferPtr->TexIndex = 0.0f;
-            data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-            data.QuadVertexBufferPtr++;
+            s_SortEntries.resize(count);
+            s_SortScratch.resize(count);
+            s_SortedSprites.resize(count);
         }
 
-        data.QuadIndexCount += 6;
-        data.Stats.QuadCount++;
+        for (Uint i = 0; i < count; i++)
+            s_SortEntries[i] = { MakeSortKey(sprites[i]), i };
+        RadixSort(s_SortEntries.data(), s_SortScratch.data(), count);
+
+        for (Uint i = 0; i < count; i++)
+            s_SortedSprites[i] = sprites[s_SortEntries[i].Index];
+        return s_SortedSprites.data();
+    }
+
+    //// Culling ///////////////////////////////////////////////////////////////////////
+
+    static Vector<SpriteSubmission> s_VisibleSprites;
+
+    static AABB GetSpriteBounds(const glm::mat4& transform)
+    {
+        // The quad spans [-0.5, 0.5] along its first two axes
+        glm::vec3 center = transform[3];
+        glm::vec3 extents = (glm::abs(glm::vec3(transform[0])) + glm::abs(glm::vec3(transform[1]))) * 0.5f;
+        return AABB(center - extents, center + extents);
+    }
+
+    /* [Spike] Keeps the sprites whose world space bounds touch the view frustum of the current scene [Spike] */
+    static const SpriteSubmission* CullSprites(const SpriteSubmission* sprites, Uint& count)
+    {
+        s_VisibleSprites.clear();
+        for (Uint i = 0; i < count; i++)
+        {
+            if (data.ViewFrustum.Intersects(GetSpriteBounds(sprites[i].Transform->GetWorldTransform())))
+                s_VisibleSprites.push_back(sprites[i]);
+        }
+
+        data.Stats.SpritesCulled += count - (Uint)s_VisibleSprites.size();
+        data.Stats.SpritesDrawn += (Uint)s_VisibleSprites.size();
+        count = (Uint)s_VisibleSprites.size();
+        return s_VisibleSprites.data();
+    }
+
+    /* [Spike] Builds and draws sprites that are already culled and in draw order [Spike] */
+    static void DrawSortedSprites(const SpriteSubmission* sprites, Uint count)
+    {
+        Uint rangeCount = std::min(JobSystem::GetThreadCount(), count / MinSpritesPerRange);
+        if (rangeCount <= 1)
+        {
+            // Not worth waking up other threads
+            for (Uint i = 0; i < count; i++)
+                DrawSprite(sprites[i].Transform->GetWorldTransform(), *sprites[i].Sprite);
+            return;
+        }
+
+        // Whatever was submitted before has to be drawn first
+        Flush();
+
+        if (data.Mode == SpriteRenderMode::Instanced)
+        {
+            if (s_StagingInstances.size() < count)
+                s_StagingInstances.resize(count);
+        }
+        else if (s_StagingVertices.size() < (size_t)count * 4)
+            s_StagingVertices.resize((size_t)count * 4);
+
+        /* [Spike] Build: one range per thread, the calling thread takes the first one and helps out with the rest [Spike] */
+        FrameVector<FrameVector<SpriteChunk>> rangeChunks(rangeCount);
+        JobCounter counter;
+        const Uint rangeSize = (count + rangeCount - 1) / rangeCount;
+        for (Uint r = 1; r < rangeCount; r++)
+        {
+            Uint begin = std::min(count, r * rangeSize), end = std::min(count, begin + rangeSize);
+            FrameVector<SpriteChunk>& chunks = rangeChunks[r];
+            JobSystem::Run([sprites, begin, end, &chunks]() { BuildSpriteRange(sprites, begin, end, chunks); }, &counter);
+        }
+        BuildSpriteRange(sprites, 0, std::min(count, rangeSize), rangeChunks[0]);
+        JobSystem::Wait(counter);
+
+        /* [Spike] Merge: walk the chunks in submission order, packing as many as fit into each draw. Chunks whose local slots
+         * don't line up with the batch get their texture indices rewritten in place [Spike] */
+        StartBatch();
+        Uint batchFirstQuad = 0, batchQuadCount = 0;
+        for (auto& chunks : rangeChunks)
+        {
+            for (auto& chunk : chunks)
+            {
+                Uint newTextures = 0;
+                for (Uint t = 1; t <= chunk.TextureCount; t++)
+                    newTextures += chunk.Textures[t]->IsInBatch(data.BatchID) ? 0 : 1;
+
+                const bool outOfSlots = data.TextureSlotIndex + newTextures > Renderer2DData::MaxTextureSlots;
+                if (batchQuadCount && (batchQuadCount + chunk.QuadCount > Renderer2DData::MaxQuads || outOfSlots))
+                {
+                    DrawBatch(GetStagingQuad(batchFirstQuad), batchQuadCount);
+                    StartBatch();
+                    batchQuadCount = 0;
+                    data.Stats.TextureSlotFlushes += outOfSlots ? 1 : 0;
+                }
+                if (batchQuadCount == 0)
+                    batchFirstQuad = chunk.FirstQuad;
+                SPK_CORE_ASSERT(batchFirstQuad + batchQuadCount == chunk.FirstQuad, "Sprite chunks must be contiguous!");
+
+                float remap[Renderer2DData::MaxTextureSlots] = { 0.0f };
+                bool identity = true;
+                for (Uint t = 1; t <= chunk.TextureCount; t++)
+                {
+                    const Texture2D* texture = chunk.Textures[t];
+                    if (!texture->IsInBatch(data.BatchID))
+                    {
+                        texture->SetBatchSlot(data.BatchID, data.TextureSlotIndex);
+                        data.TextureSlots[data.TextureSlotIndex] = Ref<Texture2D>(const_cast<Texture2D*>(texture));
+                        data.TextureSlotIndex++;
+                    }
+                    remap[t] = (float)texture->GetBatchSlot();
+                    identity &= texture->GetBatchSlot() == t;
+                }
+                if (!identity)
+                    RemapTextureSlots(chunk, remap);
+
+                batchQuadCount += chunk.QuadCount;
+            }
+        }
+        if (batchQuadCount)
+            DrawBatch(GetStagingQuad(batchFirstQuad), batchQuadCount);
+
+        data.Stats.QuadCount += count;
+        StartBatch();
+    }
+
+    void DrawSprites(const SpriteSubmission* sprites, Uint count)
+    {
+        SPK_MEMORY_TAG(Renderer2D);
+        SPK_PROFILE_FUNCTION();
+        sprites = CullSprites(sprites, count);
+        if (data.SortMode != SpriteSortMode::None)
+            sprites = SortSprites(sprites, count);
+        DrawSortedSprites(sprites, count);
+    }
+
+    //// Static sprites ////////////////////////////////////////////////////////////////
+
+    /* [Spike] Sorts the sprites and splits them into chunks, assigning every member its chunk local texture slot.
+     * GPU buffers of the previous layout are kept and reused by index [Spike] */
+    static void RebuildStaticLayout(StaticSpriteCache& cache, const SpriteSubmission* sprites, Uint count)
+    {
+        cache.Submissions.assign(sprites, sprites + count);
+        const SpriteSubmission* ordered = data.SortMode != SpriteSortMode::None ? SortSprites(sprites, count) : sprites;
+
+        Vector<StaticSpriteCache::Chunk> previous = std::move(cache.Chunks);
+        cache.Chunks.clear();
+        cache.Members.resize(count);
+
+        auto beginChunk = [&](Uint firstMember, uint64_t layerKey)
+        {
+            StaticSpriteCache::Chunk chunk;
+            if (cache.Chunks.size() < previous.size())
+            {
+                auto& reused = previous[cache.Chunks.size()];
+                chunk.Buffer = reused.Buffer;
+                chunk.Pipeline = reused.Pipeline;
+                chunk.Capacity = reused.Capacity;
+            }
+            chunk.Textures.push_back(data.WhiteTexture);
+            chunk.FirstMember = firstMember;
+            chunk.LayerKey = layerKey;
+            cache.Chunks.push_back(std::move(chunk));
+        };
+
+        for (Uint i = 0; i < count; i++)
+        {
+            const SpriteRendererComponent& sprite = *ordered[i].Sprite;
+            const Texture2D* texture = sprite.Texture ? sprite.Texture.Raw() : nullptr;
+            // A chunk never spans two layers, so dynamic sprites of the layers in between can be drawn between them
+            const uint64_t layerKey = data.SortMode != SpriteSortMode::None ? GetLayerKey(s_SortEntries[i].Key) : 0;
+            if (cache.Chunks.empty() || cache.Chunks.back().MemberCount == Renderer2DData::MaxQuads || cache.Chunks.back().LayerKey != layerKey)
+                beginChunk(i, layerKey);
+
+            Uint slot = 0;
+            if (texture)
+            {
+                auto& textures = cache.Chunks.back().Textures;
+                for (Uint t = 1; t < textures.size() && !slot; t++)
+                    slot = textures[t].Raw() == texture ? t : 0;
+
+                if (!slot)
+                {
+                    if (cache.Chunks.back().Textures.size() == Renderer2DData::MaxTextureSlots)
+                        beginChunk(i, layerKey);
+                    slot = (Uint)cache.Chunks.back().Textures.size();
+                    cache.Chunks.back().Textures.push_back(sprite.Texture);
+                }
+            }
+
+            StaticSpriteCache::Member& member = cache.Members[i];
+            member.Submission = ordered[i];
+            member.Texture = texture;
+            member.TexIndex = (float)slot;
+            member.SortingLayer = sprite.SortingLayer;
+            member.OrderInLayer = sprite.OrderInLayer;
+            cache.Chunks.back().MemberCount++;
+        }
+    }
+
+    static void BakeStaticChunk(StaticSpriteCache& cache, StaticSpriteCache::Chunk& chunk)
+    {
+        const bool instanced = data.Mode == SpriteRenderMode::Instanced;
+        const Uint quadSize = (Uint)(instanced ? sizeof(QuadInstance) : sizeof(QuadVertex) * 4);
+        if (!chunk.Buffer || chunk.Capacity < chunk.MemberCount)
+        {
+            chunk.Buffer = VertexBuffer::Create(chunk.MemberCount * quadSize, data.QuadVertexBuffer->GetLayout());
+            chunk.Capacity = chunk.MemberCount;
+
+            PipelineSpecification spec = {};
+            spec.Shader = data.TextureShader;
+            spec.IndexBuffer = data.QuadPipeline->GetSpecification().IndexBuffer;
+            spec.VertexBuffer = chunk.Buffer;
+            chunk.Pipeline = Pipeline::Create(spec);
+            chunk.Pipeline->SetPrimitiveTopology(PrimitiveTopology::TRIANGLELIST);
+        }
+
+        if (instanced && s_StagingInstances.size() < chunk.MemberCount)
+            s_StagingInstances.resize(chunk.MemberCount);
+        else if (!instanced && s_StagingVertices.size() < (size_t)chunk.MemberCount * 4)
+            s_StagingVertices.resize((size_t)chunk.MemberCount * 4);
+
+        for (Uint i = 0; i < chunk.MemberCount; i++)
+        {
+            StaticSpriteCache::Member& member = cache.Members[chunk.FirstMember + i];
+            const SpriteRendererComponent& sprite = *member.Submission.Sprite;
+            const glm::mat4& transform = member.Submission.Transform->GetWorldTransform();
+            member.WorldVersion = member.Submission.Transform->GetWorldVersion();
+            member.Color = sprite.Color;
+            member.TilingFactor = sprite.TilingFactor;
+
+            QuadAttributes attributes = { data.QuadVertexPositions, s_FlatTextureCoords, sprite.Color, member.TexIndex, 1.0f };
+            if (member.Texture)
+            {
+                attributes.TexCoords = s_TextureCoords;
+                attributes.TilingFactor = sprite.TilingFactor;
+            }
+
+            if (instanced)
+                EmitInstances(&s_StagingInstances[i], &transform, 1, attributes);
+            else
+                data.EmitQuads(&s_StagingVertices[(size_t)i * 4], &transform, 1, attributes);
+
+            AABB bounds = GetSpriteBounds(transform);
+            chunk.Bounds = i == 0 ? bounds : AABB(glm::min(chunk.Bounds.Min, bounds.Min), glm::max(chunk.Bounds.Max, bounds.Max));
+        }
+
+        const void* quads = instanced ? (const void*)s_StagingInstances.data() : (const void*)s_StagingVertices.data();
+        chunk.Buffer->SetData(BufferView(quads, chunk.MemberCount * quadSize));
+        data.Stats.UploadedBytes += chunk.MemberCount * quadSize;
+        data.Stats.StaticChunksRebaked++;
+        chunk.Dirty = false;
+    }
+
+    /* [Spike] Regroups the cache if the set of sprites, a texture or a layer changed, flags the chunks that need a rebake [Spike] */
+    static void UpdateStaticSprites(StaticSpriteCache& cache, const SpriteSubmission* sprites, Uint count)
+    {
+        bool relayout = cache.Submissions.size() != count ||
+            (count && memcmp(cache.Submissions.data(), sprites, count * sizeof(SpriteSubmission)) != 0);
+
+        for (auto& chunk : cache.Chunks)
+        {
+            for (Uint i = chunk.FirstMember; i < chunk.FirstMember + chunk.MemberCount && !relayout; i++)
+            {
+                const StaticSpriteCache::Member& member = cache.Members[i];
+                const SpriteRendererComponent& sprite = *member.Submission.Sprite;
+                const Texture2D* texture = sprite.Texture ? sprite.Texture.Raw() : nullptr;
+                relayout = texture != member.Texture || sprite.SortingLayer != member.SortingLayer || sprite.OrderInLayer != member.OrderInLayer;
+                chunk.Dirty |= member.Submission.Transform->GetWorldVersion() != member.WorldVersion ||
+                    sprite.Color != member.Color || sprite.TilingFactor != member.TilingFactor;
+            }
+            if (relayout)
+                break;
+        }
+
+        if (relayout)
+            RebuildStaticLayout(cache, sprites, count);
+    }
+
+    static void DrawStaticChunks(StaticSpriteCache& cache, Uint firstChunk, Uint endChunk)
+    {
+        if (firstChunk == endChunk)
+            return;
+
+        // Whatever was submitted before has to be drawn first
+        Flush();
+
+        const bool instanced = data.Mode == SpriteRenderMode::Instanced;
+        for (Uint c = firstChunk; c < endChunk; c++)
+        {
+            StaticSpriteCache::Chunk& chunk = cache.Chunks[c];
+            if (chunk.Dirty)
+                BakeStaticChunk(cache, chunk);
+
+            if (!data.ViewFrustum.Intersects(chunk.Bounds))
+            {
+                data.Stats.SpritesCulled += chunk.MemberCount;
+                continue;
+            }
+
+            for (Uint t = 0; t < chunk.Textures.size(); t++)
+                chunk.Textures[t]->Bind(t, ShaderDomain::PIXEL);
+
+            chunk.Pipeline->Bind();
+            if (instanced)
+                RenderCommand::DrawIndexedInstanced(chunk.Pipeline, 6, chunk.MemberCount);
+            else
+                RenderCommand::DrawIndexed(chunk.Pipeline, chunk.MemberCount * 6);
+
+            data.Stats.DrawCalls++;
+            data.Stats.QuadCount += chunk.MemberCount;
+            data.Stats.SpritesDrawn += chunk.MemberCount;
+            data.Stats.StaticChunksDrawn++;
+        }
+
+        data.QuadPipeline->Bind();
+        StartBatch();
+    }
+
+    void DrawStaticSprites(StaticSpriteCache& cache, const SpriteSubmission* sprites, Uint count)
+    {
+        DrawSprites(cache, sprites, count, nullptr, 0);
+    }
+
+    void DrawSprites(StaticSpriteCache& cache, const SpriteSubmission* staticSprites, Uint staticCount, const SpriteSubmission* sprites, Uint count)
+    {
+        SPK_MEMORY_TAG(Renderer2D);
+        SPK_PROFILE_FUNCTION();
+        // The static layout sorts with the same buffers, it has to be done before the dynamic sprites are sorted
+        UpdateStaticSprites(cache, staticSprites, staticCount);
+        sprites = CullSprites(sprites, count);
+        if (data.SortMode != SpriteSortMode::None)
+            sprites = SortSprites(sprites, count);
+
+        /* [Spike] Walk both in layer order: for every layer its static chunks, then its dynamic sprites. The keys of the
+         * sorted sprites are still in s_SortEntries [Spike] */
+        auto spriteLayer = [](Uint i) { return data.SortMode != SpriteSortMode::None ? GetLayerKey(s_SortEntries[i].Key) : 0; };
+        const Uint chunkCount = (Uint)cache.Chunks.size();
+        Uint chunk = 0, sprite = 0;
+        while (chunk < chunkCount || sprite < count)
+        {
+            uint64_t layer = UINT64_MAX;
+            if (chunk < chunkCount)
+                layer = cache.Chunks[chunk].LayerKey;
+            if (sprite < count)
+                layer = std::min(layer, spriteLayer(sprite));
+
+            Uint chunkEnd = chunk, spriteEnd = sprite;
+            while (chunkEnd < chunkCount && cache.Chunks[chunkEnd].LayerKey == layer)
+                chunkEnd++;
+            while (spriteEnd < count && spriteLayer(spriteEnd) == layer)
+                spriteEnd++;
+
+            DrawStaticChunks(cache, chunk, chunkEnd);
+            DrawSortedSprites(sprites + sprite, spriteEnd - sprite);
+            chunk = chunkEnd;
+            sprite = spriteEnd;
+        }
+    }
+
+    SpriteRenderMode GetRenderMode() { return data.Mode; }
+    void SetSortMode(SpriteSortMode mode) { data.SortMode = mode; }
+    SpriteSortMode GetSortMode() { return data.SortMode; }
+
+    const char* GetQuadEmitterName()
+    {
+        return data.EmitQuads == EmitQuadsAVX2 ? "AVX2" : "Scalar";
+    }
+
+    QuadEmitterBenchmark BenchmarkQuadEmitters(Uint quadCount)
+    {
+        /* [Spike] Emits into a scratch buffer, nothing reaches the GPU. Transforms vary per quad so nothing gets hoisted [Spike] */
+        Vector<glm::mat4> transforms(quadCount);
+        for (Uint i = 0; i < quadCount; i++)
+            transforms[i] = glm::translate(glm::mat4(1.0f), { (float)(i % 256), (float)(i / 256), 0.0f });
+        Vector<QuadVertex> vertices((size_t)quadCount * 4);
+        QuadAttributes attributes = { data.QuadVertexPositions, s_FlatTextureCoords, glm::vec4(1.0f), 0.0f, 1.0f };
+
+        auto measure = [&](QuadEmitterFn emitter)
+        {
+            emitter(vertices.data(), transforms.data(), quadCount, attributes); // Warm up the caches
+            Clock clock;
+            emitter(vertices.data(), transforms.data(), quadCount, attributes);
+            float seconds = clock.GetElapsedTime().AsSeconds();
+            return seconds > 0.0f ? (double)quadCount / seconds : 0.0;
+        };
+
+        QuadEmitterBenchmark result;
+        result.QuadCount = quadCount;
+        result.ScalarQuadsPerSecond = measure(EmitQuadsScalar);
+        if (SelectQuadEmitter() == EmitQuadsAVX2)
+            result.AVX2QuadsPerSecond = measure(EmitQuadsAVX2);
+        return result;
     }
 
     void UpdateStats() { memset(&data.Stats, 0, sizeof(Statistics)); }
@@ -4,11 +4,27 @@
 #include "Spike/Renderer/Texture.h"
 #include "Spike/Renderer/Camera.h"
 #include "Spike/Renderer/EditorCamera.h"
+#include "Spike/Renderer/Pipeline.h"
+#include "Spike/Math/AABB.h"
 #include "Spike/Scene/Components.h"
 
 namespace Spike::Renderer2D
 {
-    void Init();
+    enum class SpriteRenderMode
+    {
+        Batched = 0, // Every quad is expanded into 4 vertices on the CPU
+        Instanced    // One record per quad, the vertex shader expands it
+    };
+
+    /* [Spike] How DrawSprites orders sprites before batching them [Spike] */
+    enum class SpriteSortMode
+    {
+        None = 0,  // Submission order
+        Layered,   // SortingLayer, OrderInLayer, then opaque colors by texture and textured or translucent ones back to front
+        OpaqueOnly // Texture only, for scenes without blending where only the flush count matters
+    };
+
+    void Init(SpriteRenderMode mode = SpriteRenderMode::Batched);
     void Shutdown();
 
     void BeginScene(const Camera& camera, const glm::mat4& transform);
@@ -17,7 +33,64 @@ namespace Spike::Renderer2D
 
     void DrawQuad(const glm::mat4& transform, const glm::vec4& color);
     void DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
-    void DrawSprite(const glm::mat4& transform, SpriteRendererComponent& sprite);
+    void DrawQuads(const glm::mat4* transforms, Uint count, const glm::vec4& color);
+    void DrawQuads(const glm::mat4* transforms, Uint count, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+    void DrawSprite(const glm::mat4& transform, const SpriteRendererComponent& sprite);
+
+    /* [Spike] One sprite for DrawSprites. The world matrix is fetched (and its cache rebuilt) by the thread that builds the quad [Spike] */
+    struct SpriteSubmission
+    {
+        const TransformComponent* Transform;
+        const SpriteRendererComponent* Sprite;
+    };
+
+    /* [Spike] Culls the sprites against the camera given to BeginScene, sorts the rest by the current SpriteSortMode,
+     * then builds large lists on all cores [Spike] */
+    void DrawSprites(const SpriteSubmission* sprites, Uint count);
+
+    /* [Spike] Persistent GPU copies of the sprites flagged Static, owned by the scene that submits them. The sprites are sorted
+     * once and grouped into chunks of at most MaxQuads sprites and 31 textures, never spanning two layers. A chunk is rebaked
+     * only when one of its members moved or changed color, a changed texture or layer or a different set of sprites regroups
+     * everything [Spike] */
+    struct StaticSpriteCache
+    {
+        struct Member
+        {
+            SpriteSubmission Submission;
+            Uint WorldVersion = 0;
+            glm::vec4 Color;
+            const Texture2D* Texture = nullptr;
+            float TilingFactor = 1.0f;
+            float TexIndex = 0.0f; // Slot in the chunk
+            int SortingLayer = 0;
+            int OrderInLayer = 0;
+        };
+
+        struct Chunk
+        {
+            Ref<VertexBuffer> Buffer;
+            Ref<Spike::Pipeline> Pipeline;
+            Uint Capacity = 0; // Quads the buffer can hold
+            Vector<Ref<Texture2D>> Textures; // [0] = white texture
+            Uint FirstMember = 0;
+            Uint MemberCount = 0;
+            AABB Bounds;
+            uint64_t LayerKey = 0; // SortingLayer and OrderInLayer of all its members, 0 unless sorting Layered
+            bool Dirty = true;
+        };
+
+        Vector<SpriteSubmission> Submissions; // In submission order, to detect a different set of sprites
+        Vector<Member> Members;               // In draw order
+        Vector<Chunk> Chunks;
+    };
+
+    /* [Spike] Draws the cached chunks, rebaking the ones that changed. They are drawn before anything submitted after this call,
+     * changing the sort mode takes effect the next time the set of static sprites changes [Spike] */
+    void DrawStaticSprites(StaticSpriteCache& cache, const SpriteSubmission* sprites, Uint count);
+
+    /* [Spike] DrawStaticSprites and DrawSprites in one, interleaved by SortingLayer and OrderInLayer: each layer's static
+     * chunks, then its dynamic sprites. Inside one layer and order the static sprites still all go first [Spike] */
+    void DrawSprites(StaticSpriteCache& cache, const SpriteSubmission* staticSprites, Uint staticCount, const SpriteSubmission* sprites, Uint count);
     void DrawDebugQuad(const glm::mat4& transform);
     void Flush();
 
@@ -25,11 +98,32 @@ namespace Spike::Renderer2D
     {
         Uint DrawCalls = 0;
         Uint QuadCount = 0;
+        Uint UploadedBytes = 0; // Vertex/instance data sent to the GPU this frame
+        Uint TextureSlotFlushes = 0; // Draw calls forced by running out of texture slots
+        Uint SpritesDrawn = 0;  // DrawSprites and DrawStaticSprites only
+        Uint SpritesCulled = 0; // DrawSprites and DrawStaticSprites only
+        Uint StaticChunksDrawn = 0;
+        Uint StaticChunksRebaked = 0;
         Uint GetTotalVertexCount() const { return QuadCount * 4; }
         Uint GetTotalIndexCount() const { return QuadCount * 6; }
     };
 
+    SpriteRenderMode GetRenderMode();
+    void SetSortMode(SpriteSortMode mode);
+    SpriteSortMode GetSortMode();
+
     void UpdateStats();
     Statistics GetStats();
+
+    struct QuadEmitterBenchmark
+    {
+        Uint QuadCount = 0;
+        double ScalarQuadsPerSecond = 0.0;
+        double AVX2QuadsPerSecond = 0.0; // 0 if the CPU has no AVX2
+    };
+
+    /* [Spike] Name of the vertex emitter picked at Init, "AVX2" or "Scalar" [Spike] */
+    const char* GetQuadEmitterName();
+    QuadEmitterBenchmark BenchmarkQuadEmitters(Uint quadCount = 100000);
     void StartBatch();
 }
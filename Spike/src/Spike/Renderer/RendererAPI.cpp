@@ -10,7 +10,9 @@ namespace Spike
         RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
     #elif defined RENDERER_API_DX11
         RendererAPI::API RendererAPI::s_API = RendererAPI::API::DX11;
+    #elif defined RENDERER_API_NONE
+        RendererAPI::API RendererAPI::s_API = RendererAPI::API::None;
     #else
-        #error No RendererAPI selected! RendererAPI 'NONE' is currently not supported!
+        #error No RendererAPI selected!
     #endif
 }
\ No newline at end of file
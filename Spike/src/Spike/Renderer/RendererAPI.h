@@ -54,6 +54,7 @@ namespace Spike
 
         virtual void DrawIndexed(Ref<Pipeline>& pipeline, Uint indexCount = 0) = 0;
         virtual void DrawIndexedMesh(Uint indexCount, Uint baseIndex, Uint baseVertex) = 0;
+        virtual void DrawIndexedInstanced(Ref<Pipeline>& pipeline, Uint indexCount, Uint instanceCount) = 0;
         virtual void BindBackbuffer() = 0;
         virtual void BeginWireframe() = 0;
         virtual void EndWireframe() = 0;
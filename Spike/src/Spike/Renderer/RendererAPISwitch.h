@@ -3,5 +3,8 @@
 #pragma once
 
 /* [Spike] Uncomment/Comment these #define 's to switch the RendererAPI [Spike] */
-#define RENDERER_API_DX11 // DirectX 11
-//#define RENDERER_API_OPENGL // OpenGL
+/* [Spike] Headless builds define RENDERER_API_NONE from CMake (SPK_HEADLESS), which records commands instead of drawing [Spike] */
+#ifndef RENDERER_API_NONE
+    #define RENDERER_API_DX11 // DirectX 11
+    //#define RENDERER_API_OPENGL // OpenGL
+#endif
@@ -6,6 +6,7 @@
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 #include "Platform/DX11/DX11Shader.h"
+#include "Platform/Null/NullShader.h"
 
 namespace Spike
 {
@@ -13,7 +14,7 @@ namespace Spike
     {
         switch (RendererAPI::GetAPI())
         {
-            case RendererAPI::API::None:    SPK_INTERNAL_ASSERT("RendererAPI::None is currently not supported!"); return nullptr;
+            case RendererAPI::API::None:    return Ref<NullShader>::Create(filepath);
             case RendererAPI::API::OpenGL:  return Ref<OpenGLShader>::Create(filepath);
             case RendererAPI::API::DX11:    return Ref<DX11Shader>::Create(filepath);
         }
@@ -35,13 +35,14 @@ namespace Spike
 
         VertexBufferLayout layout = { { ShaderDataType::Float3, "SKYBOX_POS" } };
 
-        Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(skyboxVertices, sizeof(skyboxVertices), layout);
+        Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(BufferView(skyboxVertices, sizeof(skyboxVertices)), layout);
         Ref<IndexBuffer> indexBuffer= IndexBuffer::Create(indices, std::size(indices));
 
         Ref<Shader> skyboxShader;
         switch (RendererAPI::GetAPI())
         {
             case RendererAPI::API::DX11: skyboxShader = Shader::Create("Spike-Editor/assets/shaders/HLSL/Skybox.hlsl"); break;
+            case RendererAPI::API::None:
             case RendererAPI::API::OpenGL: skyboxShader = Shader::Create("Spike-Editor/assets/shaders/GLSL/Skybox.glsl"); break;
         }
         skyboxShader->Bind();
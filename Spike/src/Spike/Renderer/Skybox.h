@@ -17,6 +17,7 @@ namespace Spike
 
         void Render(const glm::mat4& projectionMatrix, const glm::mat4& viewMatrix);
         void SetCubemapTexture(const Ref<TextureCube>& texture) { m_Texture = texture; }
+        void SetCubemapTexture(Ref<TextureCube>&& texture) { m_Texture = std::move(texture); }
 
         /*
         Get some cool skyboxes from http://www.humus.name/index.php?page=Textures
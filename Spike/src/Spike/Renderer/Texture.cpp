@@ -6,14 +6,17 @@
 #include "Renderer.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
 #include "Platform/DX11/DX11Texture.h"
+#include "Platform/Null/NullTexture.h"
 
 namespace Spike
 {
+    std::atomic<Uint> Texture::s_NextUniqueID = 1; // 0 is reserved for untextured sprites
+
     Ref<Texture2D> Texture2D::Create(Uint width, Uint height)
     {
         switch (RendererAPI::GetAPI())
         {
-            case RendererAPI::API::None:    SPK_INTERNAL_ASSERT("RendererAPI::None is currently not supported!"); return nullptr;
+            case RendererAPI::API::None:    return Ref<NullTexture2D>::Create(width, height);
             case RendererAPI::API::OpenGL:  return Ref<OpenGLTexture2D>::Create(width, height);
             case RendererAPI::API::DX11:    return Ref<DX11Texture2D>::Create(width, height);
         }
@@ -26,7 +29,7 @@ namespace Spike
     {
         switch (RendererAPI::GetAPI())
         {
-            case RendererAPI::API::None:    SPK_INTERNAL_ASSERT("RendererAPI::None is currently not supported!"); return nullptr;
+            case RendererAPI::API::None:    return Ref<NullTexture2D>::Create(path, flipped);
             case RendererAPI::API::OpenGL:  return Ref<OpenGLTexture2D>::Create(path, flipped);
             case RendererAPI::API::DX11:    return Ref<DX11Texture2D>::Create(path, flipped);
         }
@@ -48,7 +51,7 @@ namespace Spike
     {
         switch (RendererAPI::GetAPI())
         {
-            case RendererAPI::API::None:    SPK_INTERNAL_ASSERT("RendererAPI::None is currently not supported!"); return nullptr;
+            case RendererAPI::API::None:    return Ref<NullTextureCube>::Create(folderpath);
             case RendererAPI::API::OpenGL:  return Ref<OpenGLTextureCube>::Create(folderpath);
             case RendererAPI::API::DX11:    return Ref<DX11TextureCube>::Create(folderpath);
         }
@@ -3,7 +3,9 @@
 #pragma once
 #include "Spike/Core/Ref.h"
 #include "Spike/Core/Base.h"
+#include "Spike/Core/Buffer.h"
 #include "Spike/Renderer/Shader.h"
+#include <atomic>
 #include <string>
 #include <glm/glm.hpp>
 
@@ -19,14 +21,27 @@ namespace Spike
         virtual RendererID GetRendererID() const = 0;
         virtual String GetFilepath() const = 0;
         virtual String const GetName() const = 0;
-        virtual void SetData(void* data, Uint size) = 0;
+        virtual void SetData(BufferView data) = 0;
         virtual bool Loaded() = 0;
         virtual void Reload(bool flip = false) = 0;
         virtual void Bind(Uint slot = 0, ShaderDomain domain = ShaderDomain::PIXEL) const = 0;
         virtual void Unbind() const = 0;
         virtual bool operator==(const Texture& other) const = 0;
 
+        /* [Spike] Renderer2D stamps a texture with the batch it was given a slot in, so finding that slot again is one compare [Spike] */
+        bool IsInBatch(uint64_t batchID) const { return m_BatchID == batchID; }
+        Uint GetBatchSlot() const { return m_BatchSlot; }
+        void SetBatchSlot(uint64_t batchID, Uint slot) const { m_BatchID = batchID; m_BatchSlot = slot; }
+
+        /* [Spike] Small id, unique for the lifetime of the process, Renderer2D groups sprites by it when sorting [Spike] */
+        Uint GetUniqueID() const { return m_UniqueID; }
+
         static Uint CalculateMipMapCount(Uint width, Uint height);
+    private:
+        mutable uint64_t m_BatchID = 0; // 0 is never a valid batch
+        mutable Uint m_BatchSlot = 0;
+        Uint m_UniqueID = s_NextUniqueID.fetch_add(1, std::memory_order_relaxed);
+        static std::atomic<Uint> s_NextUniqueID; // Textures get created on worker threads too
     };
 
     class Texture2D : public Texture
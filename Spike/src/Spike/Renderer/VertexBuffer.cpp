@@ -6,6 +6,7 @@
 #include "VertexBuffer.h"
 #include "Platform/OpenGL/OpenGLVertexBuffer.h"
 #include "Platform/DX11/DX11VertexBuffer.h"
+#include "Platform/Null/NullVertexBuffer.h"
 
 namespace Spike
 {
@@ -13,7 +14,7 @@ namespace Spike
     {
         switch (RendererAPI::GetAPI())
         {
-            case RendererAPI::API::None:    SPK_INTERNAL_ASSERT("RendererAPI::None is currently not supported!"); return nullptr;
+            case RendererAPI::API::None:    return Ref<NullVertexBuffer>::Create(size, layout);
             case RendererAPI::API::OpenGL:  return Ref<OpenGLVertexBuffer>::Create(size, layout);
             case RendererAPI::API::DX11:    return Ref<DX11VertexBuffer>::Create(size, layout);
         }
@@ -23,13 +24,13 @@ namespace Spike
     }
 
 
-    Ref<VertexBuffer> VertexBuffer::Create(void* vertices, Uint size, VertexBufferLayout layout)
+    Ref<VertexBuffer> VertexBuffer::Create(BufferView vertices, VertexBufferLayout layout)
     {
         switch (RendererAPI::GetAPI())
         {
-            case RendererAPI::API::None:    SPK_INTERNAL_ASSERT("RendererAPI::None is currently not supported!"); return nullptr;
-            case RendererAPI::API::OpenGL:  return Ref<OpenGLVertexBuffer>::Create(vertices, size, layout);
-            case RendererAPI::API::DX11:    return Ref<DX11VertexBuffer>::Create(vertices, size, layout);
+            case RendererAPI::API::None:    return Ref<NullVertexBuffer>::Create(vertices, layout);
+            case RendererAPI::API::OpenGL:  return Ref<OpenGLVertexBuffer>::Create(vertices, layout);
+            case RendererAPI::API::DX11:    return Ref<DX11VertexBuffer>::Create(vertices, layout);
         }
 
         SPK_INTERNAL_ASSERT("Unknown RendererAPI!");
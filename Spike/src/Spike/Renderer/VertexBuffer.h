@@ -2,6 +2,7 @@
 //Copyright 2021 - SpikeTechnologies - All Rights Reserved
 #pragma once
 #include "Spike/Core/Ref.h"
+#include "Spike/Core/Buffer.h"
 
 namespace Spike
 {
@@ -66,18 +67,26 @@ namespace Spike
         }
     };
 
+    /* [Spike] PerInstance buffers advance once per instance instead of once per vertex [Spike] */
+    enum class VertexInputRate
+    {
+        PerVertex = 0,
+        PerInstance = 1
+    };
+
     class VertexBufferLayout
     {
     public:
         VertexBufferLayout() {}
 
-        VertexBufferLayout(const std::initializer_list<VertexBufferElement>& elements)
-            :m_Elements(elements)
+        VertexBufferLayout(const std::initializer_list<VertexBufferElement>& elements, VertexInputRate inputRate = VertexInputRate::PerVertex)
+            :m_Elements(elements), m_InputRate(inputRate)
         {
             CalculateOffsetsAndStride();
         }
 
         Uint GetStride() const { return m_Stride; }
+        VertexInputRate GetInputRate() const { return m_InputRate; }
         const std::vector<VertexBufferElement>& GetElements() const { return m_Elements; }
 
         std::vector<VertexBufferElement>::iterator begin() { return m_Elements.begin(); }
@@ -99,6 +108,7 @@ namespace Spike
     private:
         std::vector<VertexBufferElement> m_Elements;
         Uint m_Stride = 0;
+        VertexInputRate m_InputRate = VertexInputRate::PerVertex;
     };
     class VertexBuffer : public RefCounted
     {
@@ -111,10 +121,10 @@ namespace Spike
         virtual const VertexBufferLayout& GetLayout() const = 0;
         virtual void SetLayout(const VertexBufferLayout& layout) = 0;
 
-        virtual void SetData(const void* data, Uint size) = 0;
+        virtual void SetData(BufferView data) = 0;
 
         static Ref<VertexBuffer> Create(Uint size, VertexBufferLayout layout);
-        static Ref<VertexBuffer> Create(void* vertices, Uint size, VertexBufferLayout layout);
+        static Ref<VertexBuffer> Create(BufferView vertices, VertexBufferLayout layout);
     };
 
 }
@@ -40,12 +40,63 @@ namespace Spike
         TransformComponent(const glm::vec3& translation)
             :Translation(translation) {}
 
-        glm::mat4 GetTransform() const
+        /* [Spike] The matrix is cached and only rebuilt when Translation, Rotation or Scale differ from the values it was built from,
+         * so writes from the editor, Physics2D or scripts don't need to flag anything [Spike] */
+        const glm::mat4& GetTransform() const
         {
-            glm::mat4 rotation = glm::toMat4(glm::quat(Rotation));
-            return glm::translate(glm::mat4(1.0f), Translation) * rotation * glm::scale(glm::mat4(1.0f), Scale);
+            if (IsDirty())
+                Recalculate();
+            return m_Transform;
         }
+
+        bool IsDirty() const { return Translation != m_CachedTranslation || Rotation != m_CachedRotation || Scale != m_CachedScale; }
+
+        /* [Spike] Incremented every time the cached matrix is rebuilt [Spike] */
+        Uint GetVersion() const { return m_Version; }
+
+        /* [Spike] Parent * local, written by Scene::UpdateWorldTransforms(). Entities without a parent return the local matrix [Spike] */
+        const glm::mat4& GetWorldTransform() const { return m_HasParent ? m_WorldTransform : GetTransform(); }
+        bool HasParent() const { return m_HasParent; }
+
+        /* [Spike] Changes whenever GetWorldTransform() may return a different matrix [Spike] */
+        Uint GetWorldVersion() const { GetTransform(); return m_Version + m_WorldVersion; }
         void Reset() { Translation = { 0.0f, 0.0f, 0.0f }; Rotation = { 0.0f, 0.0f, 0.0f }; Scale = { 1.0f, 1.0f, 1.0f }; }
+    private:
+        void Recalculate() const
+        {
+            glm::mat4 rotation = glm::toMat4(glm::quat(Rotation));
+            m_Transform = glm::translate(glm::mat4(1.0f), Translation) * rotation * glm::scale(glm::mat4(1.0f), Scale);
+            m_CachedTranslation = Translation;
+            m_CachedRotation = Rotation;
+            m_CachedScale = Scale;
+            m_Version++;
+        }
+    private:
+        /* [Spike] Defaults match the default Translation/Rotation/Scale, so a fresh component starts clean [Spike] */
+        mutable glm::mat4 m_Transform = glm::mat4(1.0f);
+        mutable glm::vec3 m_CachedTranslation = { 0.0f, 0.0f, 0.0f };
+        mutable glm::vec3 m_CachedRotation = { 0.0f, 0.0f, 0.0f };
+        mutable glm::vec3 m_CachedScale = { 1.0f, 1.0f, 1.0f };
+        mutable Uint m_Version = 0;
+
+        glm::mat4 m_WorldTransform = glm::mat4(1.0f);
+        Uint m_WorldVersion = 0;
+        bool m_HasParent = false;
+        friend class Scene;
+    };
+
+    /* [Spike] Intrusive child list, stored as UUIDs so it survives serialization and CopySceneTo. Edit it through
+     * Scene::SetParent, never directly, the scene caches a depth sorted copy of the hierarchy [Spike] */
+    struct RelationshipComponent
+    {
+        UUID Parent = 0;
+        UUID FirstChild = 0;
+        UUID PreviousSibling = 0;
+        UUID NextSibling = 0;
+        Uint ChildrenCount = 0;
+
+        RelationshipComponent() = default;
+        RelationshipComponent(const RelationshipComponent&) = default;
     };
 
     struct SpriteRendererComponent
@@ -55,6 +106,13 @@ namespace Spike
         String TextureFilepath;
         float TilingFactor = 1.0f;
 
+        /* [Spike] Layers are drawn in ascending order, OrderInLayer breaks ties within one. See Renderer2D::SpriteSortMode [Spike] */
+        int SortingLayer = 0;   // [-128, 127]
+        int OrderInLayer = 0;   // [-2048, 2047]
+
+        /* [Spike] Static sprites are baked once into GPU buffers and only rebaked when they change. See Renderer2D::StaticSpriteCache [Spike] */
+        bool Static = false;
+
         SpriteRendererComponent() = default;
         SpriteRendererComponent(const SpriteRendererComponent&) = default;
         SpriteRendererComponent(const glm::vec4& color)
@@ -72,6 +130,9 @@ namespace Spike
         void Reset()
         {
             Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+            SortingLayer = 0;
+            OrderInLayer = 0;
+            Static = false;
             RemoveTexture();
         }
     };
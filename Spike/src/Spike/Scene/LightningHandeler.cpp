@@ -12,6 +12,7 @@ namespace Spike
         switch (RendererAPI::GetAPI())
         {
             case RendererAPI::API::DX11: shader = Vault::Get<Shader>("MeshShader.hlsl"); break;
+            case RendererAPI::API::None:
             case RendererAPI::API::OpenGL: shader = Vault::Get<Shader>("MeshShader.glsl"); break;
         }
 
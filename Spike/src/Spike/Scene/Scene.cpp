@@ -2,6 +2,8 @@
 //Copyright 2021 - SpikeTechnologies - All Rights Reserved
 #include "spkpch.h"
 #include "Scene.h"
+#include "Spike/Core/MemoryTracker.h"
+#include "Spike/Core/Profiler.h"
 #include "Spike/Renderer/Renderer2D.h"
 #include "Spike/Renderer/Renderer.h"
 #include "Spike/Scene/Components.h"
@@ -96,12 +98,178 @@ namespace Spike
 
     void Scene::DestroyEntity(Entity entity)
     {
+        if (m_Registry.has<RelationshipComponent>(entity))
+        {
+            // Children go down with their parent
+            for (auto& child : GetChildren(entity))
+                DestroyEntity(child);
+            DetachFromParent(entity);
+        }
+
         if (entity.HasComponent<ScriptComponent>())
             ScriptEngine::OnScriptComponentDestroyed(m_SceneID, entity.GetUUID());
 
+        m_EntityIDMap.erase(entity.GetUUID());
         m_Registry.destroy(entity);
     }
 
+    void Scene::SetParent(Entity entity, Entity parent)
+    {
+        SPK_CORE_ASSERT(entity != parent, "An entity can't be its own parent!");
+        if (parent && IsDescendantOf(parent, entity))
+        {
+            SPK_CORE_LOG_WARN("Cannot parent an entity to one of its own children!");
+            return;
+        }
+
+        DetachFromParent(entity);
+        if (parent)
+        {
+            UUID entityID = entity.GetUUID();
+            UUID parentID = parent.GetUUID();
+            // Emplacing can grow the component storage, so both have to exist before any reference is taken
+            if (!m_Registry.has<RelationshipComponent>(parent))
+                m_Registry.emplace<RelationshipComponent>(parent);
+            if (!m_Registry.has<RelationshipComponent>(entity))
+                m_Registry.emplace<RelationshipComponent>(entity);
+            auto& parentRelationship = m_Registry.get<RelationshipComponent>(parent);
+            auto& relationship = m_Registry.get<RelationshipComponent>(entity);
+
+            // Push front, keeps this O(1)
+            if (parentRelationship.FirstChild)
+                m_Registry.get<RelationshipComponent>(m_EntityIDMap.at(parentRelationship.FirstChild)).PreviousSibling = entityID;
+            relationship.Parent = parentID;
+            relationship.NextSibling = parentRelationship.FirstChild;
+            relationship.PreviousSibling = 0;
+            parentRelationship.FirstChild = entityID;
+            parentRelationship.ChildrenCount++;
+        }
+        m_HierarchyDirty = true;
+    }
+
+    void Scene::DetachFromParent(Entity entity)
+    {
+        if (!m_Registry.has<RelationshipComponent>(entity))
+            return;
+
+        auto& relationship = m_Registry.get<RelationshipComponent>(entity);
+        if (!relationship.Parent)
+            return;
+
+        auto& parentRelationship = m_Registry.get<RelationshipComponent>(m_EntityIDMap.at(relationship.Parent));
+        if (parentRelationship.FirstChild == entity.GetUUID())
+            parentRelationship.FirstChild = relationship.NextSibling;
+        if (relationship.PreviousSibling)
+            m_Registry.get<RelationshipComponent>(m_EntityIDMap.at(relationship.PreviousSibling)).NextSibling = relationship.NextSibling;
+        if (relationship.NextSibling)
+            m_Registry.get<RelationshipComponent>(m_EntityIDMap.at(relationship.NextSibling)).PreviousSibling = relationship.PreviousSibling;
+        parentRelationship.ChildrenCount--;
+
+        relationship.Parent = 0;
+        relationship.PreviousSibling = 0;
+        relationship.NextSibling = 0;
+        auto& transform = m_Registry.get<TransformComponent>(entity);
+        transform.m_HasParent = false;
+        transform.m_WorldVersion++;
+        m_HierarchyDirty = true;
+    }
+
+    Entity Scene::GetParent(Entity entity)
+    {
+        if (!m_Registry.has<RelationshipComponent>(entity))
+            return {};
+
+        UUID parent = m_Registry.get<RelationshipComponent>(entity).Parent;
+        auto it = m_EntityIDMap.find(parent);
+        return (parent && it != m_EntityIDMap.end()) ? it->second : Entity{};
+    }
+
+    Vector<Entity> Scene::GetChildren(Entity entity)
+    {
+        Vector<Entity> children;
+        if (!m_Registry.has<RelationshipComponent>(entity))
+            return children;
+
+        UUID child = m_Registry.get<RelationshipComponent>(entity).FirstChild;
+        while (child)
+        {
+            Entity childEntity = m_EntityIDMap.at(child);
+            children.push_back(childEntity);
+            child = m_Registry.get<RelationshipComponent>(childEntity).NextSibling;
+        }
+        return children;
+    }
+
+    bool Scene::IsDescendantOf(Entity entity, Entity ancestor)
+    {
+        for (Entity parent = GetParent(entity); parent; parent = GetParent(parent))
+            if (parent == ancestor)
+                return true;
+        return false;
+    }
+
+    void Scene::RebuildHierarchy()
+    {
+        m_HierarchyNodes.clear();
+
+        auto view = m_Registry.view<RelationshipComponent>();
+        for (auto entity : view)
+        {
+            const auto& relationship = view.get<RelationshipComponent>(entity);
+            if (!relationship.Parent && relationship.FirstChild)
+                m_HierarchyNodes.push_back({ entity, -1, 0, true });
+        }
+
+        // Breadth first walk, the array doubles as the queue, so it ends up sorted by depth
+        for (size_t i = 0; i < m_HierarchyNodes.size(); i++)
+        {
+            UUID child = m_Registry.get<RelationshipComponent>(m_HierarchyNodes[i].Entity).FirstChild;
+            while (child)
+            {
+                auto it = m_EntityIDMap.find(child);
+                if (it == m_EntityIDMap.end())
+                {
+                    SPK_CORE_LOG_WARN("Hierarchy references a missing entity (%llu), skipping it!", (uint64_t)child);
+                    break;
+                }
+
+                entt::entity childEntity = it->second;
+                m_HierarchyNodes.push_back({ childEntity, (int32_t)i, 0, true });
+                child = m_Registry.get<RelationshipComponent>(childEntity).NextSibling;
+            }
+        }
+        m_HierarchyDirty = false;
+    }
+
+    void Scene::UpdateWorldTransforms()
+    {
+        bool rebuilt = m_HierarchyDirty;
+        if (m_HierarchyDirty)
+            RebuildHierarchy();
+
+        /* [Spike] Parents are visited before their children, so one linear pass is enough. A node is only recomputed when its
+         * local matrix changed or its parent was recomputed this pass, untouched subtrees cost a version compare [Spike] */
+        for (auto& node : m_HierarchyNodes)
+        {
+            auto& transform = m_Registry.get<TransformComponent>(node.Entity);
+            const glm::mat4& local = transform.GetTransform();
+            bool parentChanged = node.Parent != -1 && m_HierarchyNodes[node.Parent].Changed;
+
+            node.Changed = rebuilt || parentChanged || transform.GetVersion() != node.LocalVersion;
+            if (!node.Changed)
+                continue;
+
+            node.LocalVersion = transform.GetVersion();
+            if (node.Parent != -1)
+            {
+                const auto& parent = m_Registry.get<TransformComponent>(m_HierarchyNodes[node.Parent].Entity);
+                transform.m_WorldTransform = parent.GetWorldTransform() * local;
+                transform.m_HasParent = true;
+                transform.m_WorldVersion++;
+            }
+        }
+    }
+
     void Scene::OnUpdate(Timestep ts)
     {
         Physics2D::Simulate(ts);
@@ -109,56 +277,84 @@ namespace Spike
 
     void Scene::OnUpdateRuntime(Timestep ts)
     {
-        Camera* mainCamera = nullptr;
-        TransformComponent cameraTransformComponent;
-        glm::mat4 cameraTransform;
+        SPK_MEMORY_TAG(Scene);
+        SPK_PROFILE_FUNCTION();
+        if (!m_RuntimeGraph)
+            BuildRuntimeGraph();
+
+        m_FrameTimestep = ts;
+        m_RuntimeGraph->Execute();
+        m_LastExecutedGraph = m_RuntimeGraph.get();
+    }
+
+    void Scene::OnUpdateEditor(Timestep ts, EditorCamera& camera)
+    {
+        SPK_MEMORY_TAG(Scene);
+        SPK_PROFILE_FUNCTION();
+        if (!m_EditorGraph)
+            BuildEditorGraph();
+
+        m_FrameTimestep = ts;
+        m_FrameEditorCamera = &camera;
+        m_EditorGraph->Execute();
+        m_LastExecutedGraph = m_EditorGraph.get();
+    }
 
+    /* [Spike] Tasks are declared in the order they used to run in, so conflicting systems keep that order. Everything that
+     * touches the graphics context or Mono is pinned to the main thread, gathering runs wherever there is a free core.
+     * The renderers wait on jobs mid batch, which runs other main thread tasks, so every task binding shaders or pipelines
+     * writes "GraphicsContext" to keep them from running inside each other [Spike] */
+    void Scene::BuildRuntimeGraph()
+    {
+        m_RuntimeGraph = CreateScope<TaskGraph>("Runtime");
+        TaskGraph& graph = *m_RuntimeGraph;
+        PrepareRegistryForTasks();
+
+        graph.AddTask("WorldTransforms", TaskAffinity::AnyThread, [this]() { UpdateTransforms(); })
+            .Reads<RelationshipComponent>().Writes<TransformComponent>();
+
+        graph.AddTask("FindPrimaryCamera", TaskAffinity::AnyThread, [this]()
         {
+            m_MainCamera = nullptr;
             auto view = m_Registry.view<TransformComponent, CameraComponent>();
             for (auto entity : view)
             {
                 auto [transform, camera] = view.get<TransformComponent, CameraComponent>(entity);
                 if (camera.Primary)
                 {
-                    mainCamera = &camera.Camera;
-                    cameraTransform = transform.GetTransform();
-                    cameraTransformComponent = transform;
+                    m_MainCamera = &camera.Camera;
+                    m_MainCameraTransform = transform.GetWorldTransform();
                     break;
                 }
             }
-        }
-        if (mainCamera)
-        {
-            {
-                Renderer2D::BeginScene(*mainCamera, cameraTransform);
-                auto group = m_Registry.group<TransformComponent>(entt::get<SpriteRendererComponent>);
-                for (auto entity : group)
-                {
-                    auto [transform, sprite] = group.get<TransformComponent, SpriteRendererComponent>(entity);
-                    Renderer2D::DrawSprite(transform.GetTransform(), sprite);
-                }
+        }).Reads<TransformComponent, CameraComponent>().Writes("MainCamera");
 
-                Renderer2D::EndScene();
-            }
-            {
-                Renderer::BeginScene(*mainCamera, cameraTransform);
-                PushLights();
+        graph.AddTask("GatherSprites", TaskAffinity::AnyThread, [this]() { GatherSprites(); })
+            .Reads<TransformComponent, SpriteRendererComponent>().Writes("SpriteSubmissions");
 
-                auto group = m_Registry.group<MeshComponent>(entt::get<TransformComponent>);
-                for (auto entity : group)
-                {
-                    auto [mesh, transform] = group.get<MeshComponent, TransformComponent>(entity);
-                    if (mesh.Mesh)
-                    {
-                        m_LightningHandeler->CalculateAndRenderLights(cameraTransformComponent.Translation, mesh.Mesh->GetMaterial());
-                        Renderer::SubmitMesh(mesh.Mesh, transform.GetTransform());
-                    }
-                }
-                Renderer::EndScene();
-            }
-        }
+        graph.AddTask("GatherLights", TaskAffinity::AnyThread, [this]() { PushLights(); })
+            .Reads<TransformComponent, SkyLightComponent, PointLightComponent>().Writes("Lights");
 
-        // Update scripts
+        graph.AddTask("SubmitSprites", TaskAffinity::MainThread, [this]()
+        {
+            if (!m_MainCamera)
+                return;
+            Renderer2D::BeginScene(*m_MainCamera, m_MainCameraTransform);
+            SubmitSprites();
+            Renderer2D::EndScene();
+        }).Reads<TransformComponent, SpriteRendererComponent>().Reads("MainCamera").Reads("SpriteSubmissions").Writes("Renderer2D").Writes("GraphicsContext");
+
+        graph.AddTask("SubmitMeshes", TaskAffinity::MainThread, [this]()
+        {
+            if (!m_MainCamera)
+                return;
+            Renderer::BeginScene(*m_MainCamera, m_MainCameraTransform);
+            SubmitMeshes(glm::vec3(m_MainCameraTransform[3]));
+            Renderer::EndScene();
+        }).Reads<TransformComponent, MeshComponent>().Reads("MainCamera").Reads("Lights").Writes("Renderer").Writes("GraphicsContext");
+
+        // Scripts can change anything, these are the ones the other tasks care about
+        graph.AddTask("UpdateScripts", TaskAffinity::MainThread, [this]()
         {
             auto view = m_Registry.view<ScriptComponent>();
             for (auto entity : view)
@@ -166,60 +362,120 @@ namespace Spike
                 Entity e = { entity, this };
                 if (ScriptEngine::ModuleExists(e.GetComponent<ScriptComponent>().ModuleName))
                 {
-                    ScriptEngine::OnUpdateEntity(e, ts);
+                    ScriptEngine::OnUpdateEntity(e, m_FrameTimestep);
                     /* [Spike] Maybe not hardcode the fixed timestep and have a settings struct? [Spike] */
                     ScriptEngine::OnFixedUpdateEntity(e, 0.02f); //0.02f is hardcoded here
                 }
             }
-        }
+        }).Writes<ScriptComponent, TransformComponent, SpriteRendererComponent, RigidBody2DComponent, CameraComponent>().Writes("ScriptEngine");
     }
 
-    void Scene::OnUpdateEditor(Timestep ts, EditorCamera& camera)
+    void Scene::BuildEditorGraph()
     {
-        {
-            Renderer2D::BeginScene(camera);
+        m_EditorGraph = CreateScope<TaskGraph>("Editor");
+        TaskGraph& graph = *m_EditorGraph;
+        PrepareRegistryForTasks();
 
-            auto group = m_Registry.group<TransformComponent>(entt::get<SpriteRendererComponent>);
-            for (auto entity : group)
-            {
-                auto [transform, sprite] = group.get<TransformComponent, SpriteRendererComponent>(entity);
-                Renderer2D::DrawSprite(transform.GetTransform(), sprite);
-            }
+        graph.AddTask("WorldTransforms", TaskAffinity::AnyThread, [this]() { UpdateTransforms(); })
+            .Reads<RelationshipComponent>().Writes<TransformComponent>();
+
+        graph.AddTask("GatherSprites", TaskAffinity::AnyThread, [this]() { GatherSprites(); })
+            .Reads<TransformComponent, SpriteRendererComponent>().Writes("SpriteSubmissions");
 
+        graph.AddTask("GatherLights", TaskAffinity::AnyThread, [this]() { PushLights(); })
+            .Reads<TransformComponent, SkyLightComponent, PointLightComponent>().Writes("Lights");
+
+        graph.AddTask("SubmitSprites", TaskAffinity::MainThread, [this]()
+        {
+            Renderer2D::BeginScene(*m_FrameEditorCamera);
+            SubmitSprites();
             Renderer2D::EndScene();
+        }).Reads<TransformComponent, SpriteRendererComponent>().Reads("SpriteSubmissions").Writes("Renderer2D").Writes("GraphicsContext");
 
+        graph.AddTask("ColliderBounds", TaskAffinity::MainThread, [this]()
+        {
             RenderCommand::BeginWireframe();
-            Renderer2D::BeginScene(camera);
+            Renderer2D::BeginScene(*m_FrameEditorCamera);
             auto view = m_Registry.view<TransformComponent, BoxCollider2DComponent>();
             for (auto entity : view)
             {
                 auto [transformComponent, boxCollider] = view.get<TransformComponent, BoxCollider2DComponent>(entity);
                 if (boxCollider.ShowBounds)
                 {
-                    glm::mat4 trans = transformComponent.GetTransform() * glm::translate(glm::mat4(1.0f), glm::vec3(boxCollider.Offset.x, boxCollider.Offset.y, 0.01f)) * glm::scale(glm::mat4(1.0f), glm::vec3(boxCollider.Size.x, boxCollider.Size.y, 1.0f));
+                    glm::mat4 trans = transformComponent.GetWorldTransform() * glm::translate(glm::mat4(1.0f), glm::vec3(boxCollider.Offset.x, boxCollider.Offset.y, 0.01f)) * glm::scale(glm::mat4(1.0f), glm::vec3(boxCollider.Size.x, boxCollider.Size.y, 1.0f));
                     Renderer2D::DrawDebugQuad(trans);
                 }
             }
             Renderer2D::EndScene();
             RenderCommand::EndWireframe();
-        }
+        }).Reads<TransformComponent, BoxCollider2DComponent>().Writes("Renderer2D").Writes("GraphicsContext");
+
+        graph.AddTask("SubmitMeshes", TaskAffinity::MainThread, [this]()
+        {
+            Renderer::BeginScene(*m_FrameEditorCamera);
+            SubmitMeshes(m_FrameEditorCamera->GetPosition());
+            Renderer::EndScene();
+        }).Reads<TransformComponent, MeshComponent>().Reads("Lights").Writes("Renderer").Writes("GraphicsContext");
+    }
+
+    void Scene::PrepareRegistryForTasks()
+    {
+        /* [Spike] EnTT creates pools and groups on first use, which is not thread safe. Create the ones the worker tasks
+         * use up front, after that they only read [Spike] */
+        (void)m_Registry.view<TransformComponent, CameraComponent>();
+        (void)m_Registry.view<TransformComponent, SkyLightComponent>();
+        (void)m_Registry.view<TransformComponent, PointLightComponent>();
+        (void)m_Registry.view<RelationshipComponent>();
+        (void)m_Registry.group<TransformComponent>(entt::get<SpriteRendererComponent>);
+    }
+
+    void Scene::UpdateTransforms()
+    {
+        UpdateWorldTransforms();
 
+        /* [Spike] Rebuild every stale local matrix now, later tasks read transforms from several threads at once and the
+         * lazy rebuild in GetTransform() would be a data race there [Spike] */
+        auto view = m_Registry.view<TransformComponent>();
+        for (auto entity : view)
+            view.get<TransformComponent>(entity).GetTransform();
+    }
+
+    void Scene::GatherSprites()
+    {
+        /* [Spike] Only pointers are gathered here, the quads themselves are built by Renderer2D, in parallel for big scenes [Spike] */
+        auto group = m_Registry.group<TransformComponent>(entt::get<SpriteRendererComponent>);
+        m_SpriteSubmissions.clear();
+        m_StaticSpriteSubmissions.clear();
+        m_SpriteSubmissions.reserve(group.size());
+        for (auto entity : group)
         {
-            Renderer::BeginScene(camera);
-            PushLights();
+            auto [transform, sprite] = group.get<TransformComponent, SpriteRendererComponent>(entity);
+            if (sprite.Static)
+                m_StaticSpriteSubmissions.push_back({ &transform, &sprite });
+            else
+                m_SpriteSubmissions.push_back({ &transform, &sprite });
+        }
+    }
 
-            auto group = m_Registry.group<MeshComponent>(entt::get<TransformComponent>);
-            for (auto entity : group)
+    void Scene::SubmitSprites()
+    {
+        SPK_PROFILE_FUNCTION();
+        Renderer2D::DrawSprites(m_StaticSprites, m_StaticSpriteSubmissions.data(), (Uint)m_StaticSpriteSubmissions.size(),
+            m_SpriteSubmissions.data(), (Uint)m_SpriteSubmissions.size());
+    }
+
+    void Scene::SubmitMeshes(const glm::vec3& cameraPosition)
+    {
+        SPK_PROFILE_FUNCTION();
+        auto group = m_Registry.group<MeshComponent>(entt::get<TransformComponent>);
+        for (auto entity : group)
+        {
+            auto [mesh, transform] = group.get<MeshComponent, TransformComponent>(entity);
+            if (mesh.Mesh)
             {
-                auto [mesh, transform] = group.get<MeshComponent, TransformComponent>(entity);
-                if (mesh.Mesh)
-                {
-                    m_LightningHandeler->CalculateAndRenderLights(camera.GetPosition(), mesh.Mesh->GetMaterial());
-                    Renderer::SubmitMesh(mesh.Mesh, transform.GetTransform());
-                }
+                m_LightningHandeler->CalculateAndRenderLights(cameraPosition, mesh.Mesh->GetMaterial());
+                Renderer::SubmitMesh(mesh.Mesh, transform.GetWorldTransform());
             }
-
-            Renderer::EndScene();
         }
     }
 
@@ -285,6 +541,7 @@ namespace Spike
 
     void Scene::CopySceneTo(Ref<Scene>& target)
     {
+        SPK_MEMORY_TAG(Scene);
         std::unordered_map<UUID, entt::entity> enttMap;
         auto idComponents = m_Registry.view<IDComponent>();
         for (auto entity : idComponents)
@@ -305,6 +562,8 @@ namespace Spike
         CopyComponent<CircleCollider2DComponent>(target->m_Registry, m_Registry, enttMap);
         CopyComponent<PointLightComponent>(target->m_Registry, m_Registry, enttMap);
         CopyComponent<SkyLightComponent>(target->m_Registry, m_Registry, enttMap);
+        CopyComponent<RelationshipComponent>(target->m_Registry, m_Registry, enttMap);
+        target->m_HierarchyDirty = true;
 
 
         const auto& entityInstanceMap = ScriptEngine::GetEntityInstanceMap();
@@ -323,6 +582,12 @@ namespace Spike
     }
 
     void Scene::DuplicateEntity(Entity entity)
+    {
+        // The copy becomes a sibling of the original, with the whole subtree duplicated under it
+        DuplicateEntityTree(entity, GetParent(entity));
+    }
+
+    Entity Scene::DuplicateEntityTree(Entity entity, Entity parent)
     {
         Entity newEntity;
         if (entity.HasComponent<TagComponent>())
@@ -340,6 +605,16 @@ namespace Spike
         CopyComponentIfExists<CircleCollider2DComponent>(newEntity.m_EntityHandle, entity.m_EntityHandle, m_Registry);
         CopyComponentIfExists<PointLightComponent>(newEntity.m_EntityHandle, entity.m_EntityHandle, m_Registry);
         CopyComponentIfExists<SkyLightComponent>(newEntity.m_EntityHandle, entity.m_EntityHandle, m_Registry);
+
+        /* [Spike] RelationshipComponent is not copied, it holds the UUIDs of the original's family. Collect the children first,
+         * creating entities can move components around in the registry. SetParent pushes to the front, going through the
+         * children backwards keeps the copies in the original sibling order [Spike] */
+        if (parent)
+            SetParent(newEntity, parent);
+        Vector<Entity> children = GetChildren(entity);
+        for (auto it = children.rbegin(); it != children.rend(); ++it)
+            DuplicateEntityTree(*it, newEntity);
+        return newEntity;
     }
 
     Entity Scene::GetPrimaryCameraEntity()
@@ -390,7 +665,7 @@ namespace Spike
             for (auto entity : view)
             {
                 auto [transform, light] = view.get<TransformComponent, PointLightComponent>(entity);
-                m_LightningHandeler->m_PointLights.push_back(PointLight{ transform.Translation, 0, light.Color, 0.0f, light.Intensity, light.Constant, light.Linear, light.Quadratic });
+                m_LightningHandeler->m_PointLights.push_back(PointLight{ glm::vec3(transform.GetWorldTransform()[3]), 0, light.Color, 0.0f, light.Intensity, light.Constant, light.Linear, light.Quadratic });
             }
         }
     }
@@ -458,4 +733,10 @@ namespace Spike
     void Scene::OnComponentAdded<SkyLightComponent>(Entity entity, SkyLightComponent& component)
     {
     }
+
+    template<>
+    void Scene::OnComponentAdded<RelationshipComponent>(Entity entity, RelationshipComponent& component)
+    {
+        m_HierarchyDirty = true;
+    }
 }
\ No newline at end of file
@@ -5,7 +5,9 @@
 #include "Spike/Core/UUID.h"
 #include "Spike/Scene/LightningHandeler.h"
 #include "Spike/Renderer/EditorCamera.h"
+#include "Spike/Renderer/Renderer2D.h"
 #include "Spike/Core/Timestep.h"
+#include "Spike/Core/TaskGraph.h"
 
 #pragma warning(push, 0)
 #include <entt.hpp>
@@ -26,6 +28,14 @@ namespace Spike
         Entity CreateEntityWithID(UUID uuid, const String& name = "", bool runtimeMap = false);
         void DestroyEntity(Entity entity);
         void DuplicateEntity(Entity entity);
+
+        /* [Spike] Pass an empty parent to detach. The local transform is kept as it is, so the entity moves with its new parent [Spike] */
+        void SetParent(Entity entity, Entity parent);
+        Entity GetParent(Entity entity);
+        Vector<Entity> GetChildren(Entity entity);
+        bool IsDescendantOf(Entity entity, Entity ancestor);
+        void UpdateWorldTransforms();
+
         void OnUpdate(Timestep ts);
         void OnUpdateRuntime(Timestep ts);
         void OnUpdateEditor(Timestep ts, EditorCamera& camera);
@@ -43,10 +53,23 @@ namespace Spike
         Entity FindEntityByTag(const String& tag);
         EntityMap GetEntityMap() { return m_EntityIDMap; }
 
+        /* [Spike] The task graph of the last OnUpdateRuntime/OnUpdateEditor, nullptr before the first one [Spike] */
+        const TaskGraph* GetFrameGraph() const { return m_LastExecutedGraph; }
+
         template<typename T>
         auto GetAllEntitiesWith() { return m_Registry.view<T>(); }
     private:
+        void BuildRuntimeGraph();
+        void BuildEditorGraph();
+        void PrepareRegistryForTasks();
+        void UpdateTransforms();
         void PushLights();
+        void GatherSprites();
+        void SubmitSprites();
+        void SubmitMeshes(const glm::vec3& cameraPosition);
+        void DetachFromParent(Entity entity);
+        void RebuildHierarchy();
+        Entity DuplicateEntityTree(Entity entity, Entity parent);
 
         template<typename T>
         void OnComponentAdded(Entity entity, T& component);
@@ -60,10 +83,35 @@ namespace Spike
         entt::entity m_SceneEntity;
         entt::registry m_Registry;
 
+        /* [Spike] Every entity that has a parent or children, breadth first, so a parent always comes before its children [Spike] */
+        struct HierarchyNode
+        {
+            entt::entity Entity;
+            int32_t Parent; // Index into m_HierarchyNodes, -1 for roots
+            Uint LocalVersion;
+            bool Changed;
+        };
+        Vector<HierarchyNode> m_HierarchyNodes;
+        bool m_HierarchyDirty = true;
+
+        Vector<Renderer2D::SpriteSubmission> m_SpriteSubmissions; // Reused every frame
+        Vector<Renderer2D::SpriteSubmission> m_StaticSpriteSubmissions;
+        Renderer2D::StaticSpriteCache m_StaticSprites;
+
+        /* [Spike] Built on first use. The tasks read their per frame inputs from the members below [Spike] */
+        Scope<TaskGraph> m_RuntimeGraph, m_EditorGraph;
+        TaskGraph* m_LastExecutedGraph = nullptr;
+        Timestep m_FrameTimestep;
+        EditorCamera* m_FrameEditorCamera = nullptr;
+        Camera* m_MainCamera = nullptr;
+        glm::mat4 m_MainCameraTransform = glm::mat4(1.0f);
+
         LightningHandeler* m_LightningHandeler = new LightningHandeler();
         friend class Physics2D;
         friend class Entity;
         friend class SceneSerializer;
         friend class SceneHierarchyPanel;
     };
+
+    SPK_POOL_ALLOCATE(Scene);
 }
\ No newline at end of file
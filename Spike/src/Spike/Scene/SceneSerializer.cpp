@@ -3,6 +3,9 @@
 
 #include "spkpch.h"
 #include "SceneSerializer.h"
+#include "Spike/Core/MemoryTracker.h"
+#include "Spike/Core/Profiler.h"
+#include "Spike/Core/Vault.h"
 #include "Entity.h"
 #include "Components.h"
 #include <yaml-cpp/yaml.h>
@@ -111,6 +114,9 @@ namespace YAML
 
 namespace Spike
 {
+    // One line per entity and component, off unless someone asks for it
+    static Logger s_SerializerLogger("Serializer", Severity::Info);
+
     static bool CheckPath(const String& path)
     {
         FILE* f = fopen(path.c_str(), "rb");
@@ -182,6 +188,21 @@ namespace Spike
                 out << YAML::EndMap; // TransformComponent
             }
 
+            if (entity.HasComponent<RelationshipComponent>())
+            {
+                out << YAML::Key << "RelationshipComponent";
+                out << YAML::BeginMap; // RelationshipComponent
+
+                auto& relationship = entity.GetComponent<RelationshipComponent>();
+                out << YAML::Key << "Parent" << YAML::Value << relationship.Parent;
+                out << YAML::Key << "FirstChild" << YAML::Value << relationship.FirstChild;
+                out << YAML::Key << "PreviousSibling" << YAML::Value << relationship.PreviousSibling;
+                out << YAML::Key << "NextSibling" << YAML::Value << relationship.NextSibling;
+                out << YAML::Key << "ChildrenCount" << YAML::Value << relationship.ChildrenCount;
+
+                out << YAML::EndMap; // RelationshipComponent
+            }
+
             if (entity.HasComponent<CameraComponent>())
             {
                 out << YAML::Key << "CameraComponent";
@@ -216,6 +237,9 @@ namespace Spike
                 out << YAML::Key << "Color" << YAML::Value << spriteRendererComponent.Color;
                 out << YAML::Key << "TextureFilepath" << YAML::Value << spriteRendererComponent.TextureFilepath;
                 out << YAML::Key << "TilingFactor" << YAML::Value << spriteRendererComponent.TilingFactor;
+                out << YAML::Key << "SortingLayer" << YAML::Value << spriteRendererComponent.SortingLayer;
+                out << YAML::Key << "OrderInLayer" << YAML::Value << spriteRendererComponent.OrderInLayer;
+                out << YAML::Key << "Static" << YAML::Value << spriteRendererComponent.Static;
                 out << YAML::EndMap; // SpriteRendererComponent
             }
 
@@ -326,6 +350,7 @@ namespace Spike
 
     void SceneSerializer::Serialize(const String& filepath)
     {
+        SPK_PROFILE_FUNCTION();
         YAML::Emitter out;
         out << YAML::BeginMap;
         out << YAML::Key << "Scene" << YAML::Value << m_Scene->GetUUID();
@@ -352,9 +377,16 @@ namespace Spike
 
     bool SceneSerializer::Deserialize(const String& filepath)
     {
+        SPK_MEMORY_TAG(Scene);
+        SPK_PROFILE_FUNCTION();
         std::vector<String> missingPaths;
+        MappedFile file = Vault::MapFile(filepath);
+        if (!file)
+            return false;
+
         YAML::Node data;
-        try { data = YAML::LoadFile(filepath); }
+        BufferViewStream stream(file);
+        try { data = YAML::Load(stream); }
         catch (const YAML::ParserException& ex)
         {
             SPK_CORE_LOG_ERROR("Failed to load .spike file '%s'\n     {1}", filepath.c_str(), ex.what());
@@ -376,6 +408,7 @@ namespace Spike
                 if (tagComponent)
                     name = tagComponent["Tag"].as<String>();
                 Entity deserializedEntity = m_Scene->CreateEntityWithID(uuid, name);
+                SPK_LOG_TRACE(s_SerializerLogger, "Deserialized entity %llu '%s'", (unsigned long long)uuid, name.c_str());
 
                 auto transformComponent = entity["TransformComponent"];
                 if (transformComponent)
@@ -387,6 +420,18 @@ namespace Spike
                     tc.Scale = transformComponent["Scale"].as<glm::vec3>();
                 }
 
+                auto relationshipComponent = entity["RelationshipComponent"];
+                if (relationshipComponent)
+                {
+                    // UUIDs are preserved on load, so the links can be read back as they are
+                    auto& component = deserializedEntity.AddComponent<RelationshipComponent>();
+                    component.Parent = relationshipComponent["Parent"].as<uint64_t>();
+                    component.FirstChild = relationshipComponent["FirstChild"].as<uint64_t>();
+                    component.PreviousSibling = relationshipComponent["PreviousSibling"].as<uint64_t>();
+                    component.NextSibling = relationshipComponent["NextSibling"].as<uint64_t>();
+                    component.ChildrenCount = relationshipComponent["ChildrenCount"].as<Uint>();
+                }
+
                 auto cameraComponent = entity["CameraComponent"];
                 if (cameraComponent)
                 {
@@ -422,6 +467,9 @@ namespace Spike
                     auto tilingFactor = spriteRendererComponent["TilingFactor"];
                     if (tilingFactor)
                         src.TilingFactor = tilingFactor.as<float>();
+                    src.SortingLayer = spriteRendererComponent["SortingLayer"] ? spriteRendererComponent["SortingLayer"].as<int>() : 0;
+                    src.OrderInLayer = spriteRendererComponent["OrderInLayer"] ? spriteRendererComponent["OrderInLayer"].as<int>() : 0;
+                    src.Static = spriteRendererComponent["Static"] ? spriteRendererComponent["Static"].as<bool>() : false;
                 }
 
                 auto meshComponent = entity["MeshComponent"];
@@ -445,7 +493,7 @@ namespace Spike
                         mat->m_Flipped = meshComponent["Material-IsTexturesFlipped"].as<bool>();
                     }
 
-                    SPK_CORE_LOG_INFO("  Mesh Asset Path: %s", meshPath.c_str());
+                    SPK_LOG_TRACE(s_SerializerLogger, "  Mesh Asset Path: %s", meshPath.c_str());
                 }
 
                 auto scriptComponent = entity["ScriptComponent"];
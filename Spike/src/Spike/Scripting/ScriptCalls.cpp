@@ -20,26 +20,26 @@ namespace Spike::Scripting
     void Spike_Console_LogInfo(MonoObject* message)
     {
         char* msg = CovertMonoObjectToCppChar(message);
-        SPK_CORE_LOG_INFO(msg);
+        SPK_CORE_LOG_INFO("%s", msg);
     }
     void Spike_Console_LogWarn(MonoObject* message)
     {
         char* msg = CovertMonoObjectToCppChar(message);
-        SPK_CORE_LOG_WARN(msg);
+        SPK_CORE_LOG_WARN("%s", msg);
     }
     void Spike_Console_LogDebug(MonoObject* message)
     {
         char* msg = CovertMonoObjectToCppChar(message);
-        SPK_CORE_LOG_DEBUG(msg); 
+        SPK_CORE_LOG_DEBUG("%s", msg); 
     }
     void Spike_Console_LogError(MonoObject* message)
     {
         char* msg = CovertMonoObjectToCppChar(message);
-        SPK_CORE_LOG_ERROR(msg);
+        SPK_CORE_LOG_ERROR("%s", msg);
     }
     void Spike_Console_LogCritical(MonoObject* message) {
         char* msg = CovertMonoObjectToCppChar(message);
-        SPK_CORE_LOG_CRITICAL(msg);
+        SPK_CORE_LOG_CRITICAL("%s", msg);
     }
 
     /* [Spike] INPUT [Spike] */
@@ -103,13 +103,18 @@ namespace Spike::Scripting
     void Spike_TransformComponent_GetTransform(uint64_t entityID, TransformComponent* outTransform)
     {
         auto& component = ValidateSceneAndReturnAComponent<TransformComponent>(ScriptEngine::GetSceneContext(), entityID);
-        *outTransform = component;
+        /* [Spike] The managed Transform only mirrors Translation, Rotation and Scale, never copy the cached matrix across [Spike] */
+        outTransform->Translation = component.Translation;
+        outTransform->Rotation = component.Rotation;
+        outTransform->Scale = component.Scale;
     }
 
     void Spike_TransformComponent_SetTransform(uint64_t entityID, TransformComponent* inTransform)
     {
         auto& component = ValidateSceneAndReturnAComponent<TransformComponent>(ScriptEngine::GetSceneContext(), entityID);
-        component = *inTransform;
+        component.Translation = inTransform->Translation;
+        component.Rotation = inTransform->Rotation;
+        component.Scale = inTransform->Scale;
     }
 
     void Spike_TransformComponent_GetTranslation(uint64_t entityID, glm::vec3* outTranslation)
@@ -2,6 +2,8 @@
 //Copyright 2021 - SpikeTechnologies - All Rights Reserved
 #include "spkpch.h"
 #include "ScriptEngine.h"
+#include "Spike/Core/MemoryTracker.h"
+#include "Spike/Core/Profiler.h"
 #include "ScriptRegistry.h"
 #include <filesystem>
 #include <mono/jit/jit.h>
@@ -170,10 +172,12 @@ namespace Spike
     /////////////////////////////////////////////////////////////////////////////////////////////////////////
     MonoAssembly* LoadAssemblyFromFile(const char* filepath)
     {
-        Vector<char> fileData = Vault::ReadBinaryFile(filepath);
+        /* [Spike] Mono copies the image out of the mapping (need_copy). Keeping the mapping alive instead would lock
+         * the dll on Windows and break rebuilding it for a reload [Spike] */
+        MappedFile fileData = Vault::MapFile(filepath);
         MonoImageOpenStatus status;
 
-        MonoImage* image = mono_image_open_from_data_full(fileData.data(), fileData.size(), 1, &status, 0);
+        MonoImage* image = mono_image_open_from_data_full((char*)fileData.GetData(), (uint32_t)fileData.GetSize(), 1, &status, 0);
         if (status != MONO_IMAGE_OK)
             return NULL;
 
@@ -200,6 +204,7 @@ namespace Spike
 
     void ScriptEngine::Init(const String& assemblyPath)
     {
+        SPK_MEMORY_TAG(Scripting);
         s_AssemblyPath = assemblyPath;
         InitMono();
         LoadSpikeRuntimeAssembly(assemblyPath);
@@ -213,6 +218,7 @@ namespace Spike
 
     void ScriptEngine::OnStartEntity(Entity entity)
     {
+        SPK_MEMORY_TAG(Scripting);
         EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneUUID(), entity.GetUUID()).Instance;
         if (entityInstance.ScriptClass->OnStartMethod)
             CallMethod(entityInstance.GetInstance(), entityInstance.ScriptClass->OnStartMethod);
@@ -220,6 +226,8 @@ namespace Spike
 
     void ScriptEngine::OnUpdateEntity(Entity entity, Timestep ts)
     {
+        SPK_MEMORY_TAG(Scripting);
+        SPK_PROFILE_FUNCTION();
         EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneUUID(), entity.GetUUID()).Instance;
         if (entityInstance.ScriptClass->OnUpdateMethod)
         {
@@ -230,6 +238,8 @@ namespace Spike
 
     void ScriptEngine::OnFixedUpdateEntity(Entity entity, float fixedTimeStep)
     {
+        SPK_MEMORY_TAG(Scripting);
+        SPK_PROFILE_FUNCTION();
         EntityInstance& entityInstance = GetEntityInstanceData(entity.GetSceneUUID(), entity.GetUUID()).Instance;
         if (entityInstance.ScriptClass->OnFixedUpdateMethod)
         {
@@ -302,6 +312,7 @@ namespace Spike
 
     void ScriptEngine::LoadSpikeRuntimeAssembly(const String& path)
     {
+        SPK_MEMORY_TAG(Scripting);
         MonoDomain* domain = nullptr;
         bool cleanup = false;
         if (s_MonoDomain)
@@ -334,6 +345,8 @@ namespace Spike
 
     void ScriptEngine::ReloadAssembly(const String& path)
     {
+        SPK_MEMORY_TAG(Scripting);
+        SPK_PROFILE_FUNCTION();
         LoadSpikeRuntimeAssembly(path);
         if (s_EntityInstanceMap.size())
         {
@@ -370,6 +383,7 @@ namespace Spike
     /* [Spike] The Creation on the script, instantiating it and Linking it! [Spike] */
     void ScriptEngine::InitScriptEntity(Entity entity)
     {
+        SPK_MEMORY_TAG(Scripting);
         Scene* scene = entity.m_Scene;
         UUID id = entity.GetComponent<IDComponent>().ID;
         auto& moduleName = entity.GetComponent<ScriptComponent>().ModuleName;
@@ -454,6 +468,7 @@ namespace Spike
     /* [Spike] This is the base class from which all the Scripts will derive 🌵 [Spike] */
     void ScriptEngine::InstantiateEntityClass(Entity entity)
     {
+        SPK_MEMORY_TAG(Scripting);
         Scene* scene = entity.m_Scene;
         UUID id = entity.GetComponent<IDComponent>().ID;
         auto& moduleName = entity.GetComponent<ScriptComponent>().ModuleName;
@@ -3,6 +3,7 @@
 #pragma once
 #include "Spike/Scene/Components.h"
 #include "Spike/Scripting/ScriptEngine.h"
+#include "Spike/Core/FrameAllocator.h"
 #include <mono/jit/jit.h>
 
 namespace Spike::Scripting
@@ -27,8 +28,10 @@ namespace Spike::Scripting
         else
         {
             MonoString* a = mono_object_to_string(obj, NULL);
-            String b = ConvertMonoStringToCppString(a);
-            char* s = _strdup(b.c_str());
+            /* [Spike] Only lives until the end of the next frame, callers just hand it to the logger [Spike] */
+            char* ptr = mono_string_to_utf8(a);
+            char* s = FrameAllocator::CopyString(ptr);
+            mono_free(ptr);
             return s;
         }
 
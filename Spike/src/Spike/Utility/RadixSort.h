@@ -0,0 +1,55 @@
+//                    SPIKE ENGINE
+//Copyright 2021 - SpikeTechnologies - All Rights Reserved
+#pragma once
+#include "Spike/Core/Base.h"
+#include <cstring>
+
+namespace Spike
+{
+    struct SortEntry
+    {
+        uint64_t Key;
+        Uint Index;
+    };
+
+    /* [Spike] Stable LSD radix sort on 64 bit keys, 8 bits per pass. Passes where every key has the same byte are skipped, so
+     * keys that only use a few bits cost a few passes. scratch must hold count entries, the result ends up in entries [Spike] */
+    inline void RadixSort(SortEntry* entries, SortEntry* scratch, size_t count)
+    {
+        if (count < 2)
+            return;
+
+        size_t histograms[8][256];
+        memset(histograms, 0, sizeof(histograms));
+        for (size_t i = 0; i < count; i++)
+        {
+            uint64_t key = entries[i].Key;
+            for (int pass = 0; pass < 8; pass++)
+                histograms[pass][(key >> (pass * 8)) & 0xFF]++;
+        }
+
+        SortEntry* src = entries;
+        SortEntry* dst = scratch;
+        for (int pass = 0; pass < 8; pass++)
+        {
+            size_t* histogram = histograms[pass];
+            if (histogram[(src[0].Key >> (pass * 8)) & 0xFF] == count)
+                continue; // Every key has the same byte here
+
+            size_t offset = 0;
+            for (int bucket = 0; bucket < 256; bucket++)
+            {
+                size_t bucketSize = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += bucketSize;
+            }
+
+            for (size_t i = 0; i < count; i++)
+                dst[histogram[(src[i].Key >> (pass * 8)) & 0xFF]++] = src[i];
+            std::swap(src, dst);
+        }
+
+        if (src != entries)
+            memcpy(entries, src, count * sizeof(SortEntry));
+    }
+}